@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Heap allocation trace recorder.
+ * Every pvPortMalloc(), pvPortMallocAlign(), pvPortMallocRsvAlign(),
+ * vPortFree() and xPortRealloc() appends a 16 byte record. Recording starts
+ * with the first allocation so a capture from boot replays the full heap
+ * history. Once the buffer is full, events are only counted.
+ */
+
+#include "printk.h"
+#include "aml_alloc_trace_ext.h"
+
+/* Kconfig cannot see FreeRTOSConfig.h, so the dependency is checked here */
+#if (configUSE_TRACE_FACILITY != 1)
+#error "CONFIG_HEAP_ALLOC_TRACE needs configUSE_TRACE_FACILITY for uxTaskGetTaskNumber()"
+#endif
+
+#ifndef allocTRACE_TIMESTAMP
+#define allocTRACE_TIMESTAMP() ((uint32_t)xHwClockSourceRead())
+#endif
+
+/* Header and records are contiguous, so a memory dump is a valid trace */
+static struct {
+	struct alloc_trace_header xHeader;
+	struct alloc_trace_record xRecords[CONFIG_HEAP_ALLOC_TRACE_RECORDS];
+} xAllocTrace;
+
+static uint8_t ucAllocTraceStopped;
+
+// vPortAllocTraceRecord
+static void vPortAllocTraceRecord(uint8_t ucType, void *pv, size_t xSize, size_t xAlignMsk)
+{
+	struct alloc_trace_record *pxRecord;
+	unsigned long flags;
+	uint8_t ucShift = 0;
+
+	while (ucShift < 31 && ((size_t)1 << ucShift) <= xAlignMsk)
+		ucShift++;
+
+	/* Nests inside the heap lock of the caller */
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	if (!ucAllocTraceStopped && xAllocTrace.xHeader.ulCount >= CONFIG_HEAP_ALLOC_TRACE_RECORDS) {
+		xAllocTrace.xHeader.ulDropped++;
+	} else if (!ucAllocTraceStopped) {
+		pxRecord = &xAllocTrace.xRecords[xAllocTrace.xHeader.ulCount++];
+		pxRecord->ulTimestamp = allocTRACE_TIMESTAMP();
+		pxRecord->ulAddr = (uint32_t)(size_t)pv;
+		pxRecord->ulSize = (uint32_t)xSize;
+		if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED ||
+		    !xTaskGetCurrentTaskHandle())
+			pxRecord->usTask = 0;
+		else
+			pxRecord->usTask = (uint16_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle());
+		pxRecord->ucType = ucType;
+		pxRecord->ucAlignShift = ucShift;
+	}
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+}
+
+// Drop the recorded events and record again
+void vPortAllocTraceStart(void)
+{
+	unsigned long flags;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	xAllocTrace.xHeader.ulCount = 0;
+	xAllocTrace.xHeader.ulDropped = 0;
+	ucAllocTraceStopped = 0;
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+}
+
+// Keep the recorded events, record nothing new
+void vPortAllocTraceStop(void)
+{
+	ucAllocTraceStopped = 1;
+}
+
+/*
+ * Print the trace as hex lines with an "atrace:" prefix, tools/heap_replay
+ * reads them back from a console log. Recording is stopped while printing.
+ */
+void vPortAllocTraceDump(void)
+{
+	const uint8_t *puc = (const uint8_t *)&xAllocTrace;
+	uint8_t ucStopped = ucAllocTraceStopped;
+	size_t xLen, i, j;
+
+	ucAllocTraceStopped = 1;
+
+	xAllocTrace.xHeader.ulMagic = ALLOC_TRACE_MAGIC;
+	xAllocTrace.xHeader.usVersion = ALLOC_TRACE_VERSION;
+	xAllocTrace.xHeader.usRecordSize = sizeof(struct alloc_trace_record);
+	xAllocTrace.xHeader.ulHeapBytes = (uint32_t)xTotalHeapBytes;
+
+	xLen = sizeof(struct alloc_trace_header) +
+	       xAllocTrace.xHeader.ulCount * sizeof(struct alloc_trace_record);
+	printk("alloc trace: %u records, %u dropped\r\n", xAllocTrace.xHeader.ulCount,
+	       xAllocTrace.xHeader.ulDropped);
+	for (i = 0; i < xLen; i += 16) {
+		printk("atrace:");
+		for (j = i; j < i + 16 && j < xLen; j++)
+			printk("%02x", puc[j]);
+		printk("\r\n");
+	}
+
+	ucAllocTraceStopped = ucStopped;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __AML_ALLOC_TRACE_EXT_H__
+#define __AML_ALLOC_TRACE_EXT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Trace layout, shared with tools/heap_replay. All fields are little endian.
+ * The header is followed by xCount records.
+ */
+#define ALLOC_TRACE_MAGIC 0x31525441 /* "ATR1" */
+#define ALLOC_TRACE_VERSION 1
+
+#define ALLOC_TRACE_MALLOC 1
+#define ALLOC_TRACE_MALLOC_ALIGN 2
+#define ALLOC_TRACE_MALLOC_RSV_ALIGN 3
+#define ALLOC_TRACE_FREE 4
+/* Marks a xPortRealloc(), the malloc and free it does are recorded after it */
+#define ALLOC_TRACE_REALLOC 5
+
+struct alloc_trace_header {
+	uint32_t ulMagic;
+	uint16_t usVersion;
+	uint16_t usRecordSize;
+	uint32_t ulCount;
+	uint32_t ulDropped;
+	uint32_t ulHeapBytes;
+	uint32_t ulReserved[3];
+};
+
+/*
+ * The format is meant for 32 bit targets. A 64 bit target only records the
+ * low 32 bits of a pointer, which tell the blocks apart as long as the heap
+ * lies within one 4 GB aligned window.
+ */
+struct alloc_trace_record {
+	uint32_t ulTimestamp; /* xHwClockSourceRead(), us */
+	uint32_t ulAddr; /* low 32 bits of the user pointer, 0 on failure */
+	uint32_t ulSize; /* requested size, block size for free, new size for realloc */
+	uint16_t usTask; /* uxTaskGetTaskNumber(), 0 before the scheduler */
+	uint8_t ucType;
+	uint8_t ucAlignShift; /* log2(xAlignMsk + 1), 0 without alignment */
+};
+
+#ifdef CONFIG_HEAP_ALLOC_TRACE
+void vPortAllocTraceStart(void);
+void vPortAllocTraceStop(void);
+void vPortAllocTraceDump(void);
+#endif
+
+#endif
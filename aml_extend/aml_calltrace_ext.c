@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Call trace helpers shared by the heap debug extensions */
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+#include "printk.h"
+#if CONFIG_BACKTRACE
+#include "stack_trace.h"
+#endif
+#endif
+
+#define UNWIND_DEPTH 5
+
+#ifdef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
+#define DEBUG_PRINT(...)
+#else
+#define DEBUG_PRINT(...) printk(__VA_ARGS__)
+#endif
+
+/* For pinpointing the location of anomalies(dump stack) */
+// print_traceitem
+static void print_traceitem(unsigned long *trace)
+{
+#if CONFIG_BACKTRACE
+	DEBUG_PRINT("\tCallTrace:\n");
+	for (int i = 0; i < UNWIND_DEPTH; i++) {
+		DEBUG_PRINT("\t");
+#ifndef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
+		print_symbol(*(trace + i));
+#endif
+	}
+#endif
+}
+// get_calltrace
+static void get_calltrace(unsigned long *trace)
+{
+#if CONFIG_BACKTRACE
+#define CT_SKIP 2
+	int32_t ret, i;
+	unsigned long _trace[32];
+
+	ret = get_backtrace(NULL, _trace, UNWIND_DEPTH + CT_SKIP);
+	if (ret)
+		for (i = 0; i < UNWIND_DEPTH; i++)
+			trace[i] = _trace[i + CT_SKIP];
+#endif
+}
@@ -13,6 +13,8 @@
 #include "aml_portable_ext.h"
 #include "aml_tasks_ext.h"
 #include "aml_dmalloc_ext.h"
+#include "aml_gwp_ext.h"
+#include "aml_alloc_trace_ext.h"
 #endif
 
 #endif
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Sampled guarded allocations.
+ * About one pvPortMalloc() in CONFIG_HEAP_GUARDED_SAMPLE_RATE is served from
+ * a small pool of slots instead of the heap. The block is placed against the
+ * end of its slot, and every slot is surrounded by canary guard regions that
+ * are checked when the block is freed. A freed slot is poisoned and kept in
+ * quarantine until the round robin reaches it again, the poison is checked
+ * before the slot is reused to catch use-after-free.
+ */
+
+#include "aml_gwp_ext.h"
+
+#define GUARDED_GUARD_SIZE 64
+#define GUARDED_CANARY_BYTE ((uint8_t)0xfe)
+#define GUARDED_POISON_BYTE ((uint8_t)0xdf)
+
+#define GUARDED_SLOT_FREE 0
+#define GUARDED_SLOT_USED 1
+#define GUARDED_SLOT_QUARANTINE 2
+
+#define GUARDED_SLOT_STRIDE (CONFIG_HEAP_GUARDED_SLOT_SIZE + GUARDED_GUARD_SIZE)
+#define GUARDED_POOL_SIZE (GUARDED_GUARD_SIZE + CONFIG_HEAP_GUARDED_SLOTS * GUARDED_SLOT_STRIDE)
+
+struct guarded_slot {
+	uint8_t *userAddr;
+	size_t requestSize;
+	uint8_t state;
+	TaskHandle_t xOwner;
+	unsigned long allocTrace[UNWIND_DEPTH];
+	unsigned long freeTrace[UNWIND_DEPTH];
+};
+
+static uint8_t guardedPoolRaw[GUARDED_POOL_SIZE + portBYTE_ALIGNMENT];
+static uint8_t *guardedPool;
+static struct guarded_slot guardedSlots[CONFIG_HEAP_GUARDED_SLOTS];
+static size_t guardedNext;
+static uint32_t guardedSeed = 0x2545f491;
+static uint32_t guardedCountdown;
+
+// slot data start
+#define GUARDED_SLOT_BASE(i) (guardedPool + GUARDED_GUARD_SIZE + (i) * GUARDED_SLOT_STRIDE)
+
+// prvGuardedNextCountdown
+static uint32_t prvGuardedNextCountdown(void)
+{
+	/* xorshift32, average distance between samples is the sample rate */
+	guardedSeed ^= guardedSeed << 13;
+	guardedSeed ^= guardedSeed >> 17;
+	guardedSeed ^= guardedSeed << 5;
+
+	return 1 + guardedSeed % (2 * CONFIG_HEAP_GUARDED_SAMPLE_RATE);
+}
+// prvGuardedInit
+static void prvGuardedInit(void)
+{
+	guardedPool = (uint8_t *)(((size_t)guardedPoolRaw + portBYTE_ALIGNMENT_MASK) &
+				  ~((size_t)portBYTE_ALIGNMENT_MASK));
+	memset(guardedPool, GUARDED_CANARY_BYTE, GUARDED_POOL_SIZE);
+	guardedCountdown = prvGuardedNextCountdown();
+}
+// xGuardedIsFilled
+static int xGuardedIsFilled(const uint8_t *start, const uint8_t *end, uint8_t pattern)
+{
+	for (; start < end; start++) {
+		if (*start != pattern)
+			return 0;
+	}
+	return 1;
+}
+// vGuardedReport
+static void vGuardedReport(const char *what, size_t pos)
+{
+	struct guarded_slot *slot = &guardedSlots[pos];
+	TaskStatus_t status;
+
+	DEBUG_PRINT("ERROR!!! guarded heap detected %s\r\n", what);
+	if (slot->xOwner) {
+		vTaskGetInfo(slot->xOwner, &status, 0, 0);
+		DEBUG_PRINT("\tTask owner:(%s) buffer address:(%lx) request size:(%lu)\r\n",
+			    status.pcTaskName, (size_t)slot->userAddr, slot->requestSize);
+	} else {
+		DEBUG_PRINT("\tTask owner:(NULL) buffer address:(%lx) request size:(%lu)\r\n",
+			    (size_t)slot->userAddr, slot->requestSize);
+	}
+	DEBUG_PRINT("\tAllocated at:\r\n");
+	print_traceitem(slot->allocTrace);
+	if (slot->state == GUARDED_SLOT_QUARANTINE) {
+		DEBUG_PRINT("\tFreed at:\r\n");
+		print_traceitem(slot->freeTrace);
+	}
+}
+// xGuardedCheckSlot
+static int xGuardedCheckSlot(size_t pos)
+{
+	struct guarded_slot *slot = &guardedSlots[pos];
+	uint8_t *base = GUARDED_SLOT_BASE(pos);
+	uint8_t *end = base + CONFIG_HEAP_GUARDED_SLOT_SIZE;
+	uint8_t *userEnd = slot->userAddr + slot->requestSize;
+
+	/* Damaged patterns are restored so they are reported only once */
+	if (slot->state == GUARDED_SLOT_USED) {
+		if (!xGuardedIsFilled(base - GUARDED_GUARD_SIZE,
+				      slot->userAddr - xHeapStructSize, GUARDED_CANARY_BYTE)) {
+			vGuardedReport("buffer underflow", pos);
+			memset(base - GUARDED_GUARD_SIZE, GUARDED_CANARY_BYTE,
+			       slot->userAddr - xHeapStructSize - (base - GUARDED_GUARD_SIZE));
+			return 1;
+		}
+		if (!xGuardedIsFilled(userEnd, end + GUARDED_GUARD_SIZE, GUARDED_CANARY_BYTE)) {
+			vGuardedReport("buffer overflow", pos);
+			memset(userEnd, GUARDED_CANARY_BYTE, end + GUARDED_GUARD_SIZE - userEnd);
+			return 1;
+		}
+	} else if (slot->state == GUARDED_SLOT_QUARANTINE) {
+		if (!xGuardedIsFilled(slot->userAddr, userEnd, GUARDED_POISON_BYTE)) {
+			vGuardedReport("use after free", pos);
+			memset(slot->userAddr, GUARDED_POISON_BYTE, slot->requestSize);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Called by pvPortMalloc() inside its critical section once the heap is set
+ * up, returns NULL when the request is not sampled.
+ */
+static void *pvGuardedSampleMalloc(size_t xWantedSize)
+{
+	struct guarded_slot *slot = NULL;
+	BlockLink_t *pxLink;
+	size_t pos = 0, i;
+	uint8_t *base;
+
+	if (xWantedSize > CONFIG_HEAP_GUARDED_SLOT_SIZE - xHeapStructSize)
+		return NULL;
+
+	if (!guardedPool)
+		prvGuardedInit();
+
+	if (--guardedCountdown == 0) {
+		guardedCountdown = prvGuardedNextCountdown();
+
+		/* Round robin keeps freed slots in quarantine as long as possible */
+		for (i = 0; i < CONFIG_HEAP_GUARDED_SLOTS; i++) {
+			pos = (guardedNext + i) % CONFIG_HEAP_GUARDED_SLOTS;
+			if (guardedSlots[pos].state != GUARDED_SLOT_USED) {
+				slot = &guardedSlots[pos];
+				guardedNext = pos + 1;
+				break;
+			}
+		}
+	}
+
+	if (slot) {
+		xGuardedCheckSlot(pos);
+
+		base = GUARDED_SLOT_BASE(pos);
+		memset(base, GUARDED_CANARY_BYTE, CONFIG_HEAP_GUARDED_SLOT_SIZE);
+
+		/* Put the block against the guard that follows the slot */
+		slot->userAddr = (uint8_t *)((size_t)(base + CONFIG_HEAP_GUARDED_SLOT_SIZE - xWantedSize) &
+					     ~((size_t)portBYTE_ALIGNMENT_MASK));
+		slot->requestSize = xWantedSize;
+		slot->state = GUARDED_SLOT_USED;
+		if (xTaskGetCurrentTaskHandle() &&
+		    xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+			slot->xOwner = xTaskGetCurrentTaskHandle();
+		else
+			slot->xOwner = NULL;
+		get_calltrace(slot->allocTrace);
+		memset(slot->freeTrace, 0, sizeof(slot->freeTrace));
+
+		/* Looks like a heap block to vPortFree() and xPortRealloc() */
+		pxLink = (BlockLink_t *)(slot->userAddr - xHeapStructSize);
+		pxLink->pxNextFreeBlock = NULL;
+		pxLink->xBlockSize = (xHeapStructSize + xWantedSize) | xBlockAllocatedBit;
+	}
+
+	return slot ? slot->userAddr : NULL;
+}
+
+// xGuardedOwns
+static int xGuardedOwns(void *pv)
+{
+	return guardedPool && (uint8_t *)pv >= guardedPool &&
+	       (uint8_t *)pv < guardedPool + GUARDED_POOL_SIZE;
+}
+
+/* Called by vPortFree() for blocks inside the guarded pool. */
+static void vGuardedFree(void *pv)
+{
+	unsigned long flags;
+	size_t pos = CONFIG_HEAP_GUARDED_SLOTS;
+	struct guarded_slot *slot;
+
+	if ((uint8_t *)pv >= GUARDED_SLOT_BASE(0))
+		pos = ((uint8_t *)pv - GUARDED_SLOT_BASE(0)) / GUARDED_SLOT_STRIDE;
+	slot = &guardedSlots[pos];
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	if (pos >= CONFIG_HEAP_GUARDED_SLOTS || slot->userAddr != pv) {
+		DEBUG_PRINT("ERROR!!! guarded heap invalid free of %p\r\n", pv);
+	} else if (slot->state != GUARDED_SLOT_USED) {
+		vGuardedReport("double free", pos);
+	} else {
+		traceFREE(pv, slot->requestSize);
+		vPortAllocTraceRecord(ALLOC_TRACE_FREE, pv, slot->requestSize, 0);
+		xGuardedCheckSlot(pos);
+		memset(slot->userAddr, GUARDED_POISON_BYTE, slot->requestSize);
+		slot->state = GUARDED_SLOT_QUARANTINE;
+		get_calltrace(slot->freeTrace);
+	}
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+}
+
+// Check every guarded slot now
+int xPortGuardedCheck(void)
+{
+	unsigned long flags;
+	int result = 0;
+
+	if (!guardedPool)
+		return 0;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	for (size_t pos = 0; pos < CONFIG_HEAP_GUARDED_SLOTS; pos++)
+		result += xGuardedCheckSlot(pos);
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+
+	return result;
+}
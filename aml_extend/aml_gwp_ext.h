@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef __AML_GWP_EXT_H__
+#define __AML_GWP_EXT_H__
+
+#ifdef CONFIG_HEAP_GUARDED_SAMPLING
+int xPortGuardedCheck(void);
+#endif
+
+#endif
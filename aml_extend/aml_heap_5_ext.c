@@ -22,6 +22,279 @@ int vPrintFreeListAfterMallocFail(void)
 	return 0;
 }
 
+#ifdef CONFIG_HEAP_PREFILL_POOL
+/*
+ * Pre-filled block pool.
+ * The idle task allocates a few blocks of CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE
+ * bytes and fills them with a pattern in slices of CONFIG_HEAP_PREFILL_POOL_SLICE
+ * bytes. pvPortCalloc() and task stack allocation take a ready block and trim
+ * it down to the requested size, so the memset is off their critical path.
+ */
+#define PREFILL_SLOT_EMPTY 0
+#define PREFILL_SLOT_FILLING 1
+#define PREFILL_SLOT_READY 2
+
+/* Zero for pvPortCalloc(), 0xa5 matches tskSTACK_FILL_BYTE in tasks.c */
+#define PREFILL_PATTERN_NUMS 2
+
+/* Leave the pool alone once the heap gets this low */
+#define PREFILL_MIN_FREE_BYTES (CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE * 4)
+
+/* A block served from a guarded slot cannot be trimmed, and the guarded pool
+   never samples a request that does not fit in a slot */
+#if defined(CONFIG_HEAP_GUARDED_SAMPLING) && (CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE < CONFIG_HEAP_GUARDED_SLOT_SIZE)
+#error "CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE must not be below CONFIG_HEAP_GUARDED_SLOT_SIZE"
+#endif
+
+struct prefill_slot {
+	uint8_t *pucBuf;
+	size_t xFilled;
+	volatile uint8_t ucState;
+};
+
+static const uint8_t ucPrefillPattern[PREFILL_PATTERN_NUMS] = {0x00, 0xa5};
+static struct prefill_slot xPrefillPool[PREFILL_PATTERN_NUMS][CONFIG_HEAP_PREFILL_POOL_SLOTS];
+
+// prvPrefillBlockSize
+static size_t prvPrefillBlockSize(size_t xWantedSize)
+{
+	/* Same size rounding as pvPortMalloc() */
+	xWantedSize += xHeapStructSize;
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+	xWantedSize += sizeof(size_t);
+#endif
+	if ((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00)
+		xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
+
+	return xWantedSize;
+}
+
+// prvPrefillLargestFreeBlock
+static size_t prvPrefillLargestFreeBlock(void)
+{
+	BlockLink_t *pxBlock;
+	size_t xLargest = 0;
+	unsigned long flags;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	if (pxEnd) {
+		for (pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock) {
+			if (pxBlock->xBlockSize > xLargest)
+				xLargest = pxBlock->xBlockSize;
+		}
+	}
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+
+	return xLargest;
+}
+
+// prvPrefillTrimBlock
+static void prvPrefillTrimBlock(BlockLink_t *pxBlock, size_t xWantedSize)
+{
+	BlockLink_t *pxNewBlockLink;
+	size_t xBlockSize = pxBlock->xBlockSize & ~xBlockAllocatedBit;
+
+	xWantedSize = prvPrefillBlockSize(xWantedSize);
+
+	if ((xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+		/* Give the unused tail back to the free list */
+		pxNewBlockLink = (void *)(((uint8_t *)pxBlock) + xWantedSize);
+		pxNewBlockLink->xBlockSize = xBlockSize - xWantedSize;
+		pxBlock->xBlockSize = xWantedSize | xBlockAllocatedBit;
+		xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+		prvInsertBlockIntoFreeList(pxNewBlockLink);
+	}
+}
+
+// prvPrefillTake
+static void *prvPrefillTake(size_t xWantedSize, uint8_t ucPattern)
+{
+	BlockLink_t *pxBlock;
+	struct prefill_slot *pxSlot;
+	void *pvReturn = NULL;
+	unsigned long flags;
+	int i, p;
+
+	if (xWantedSize == 0 || xWantedSize > CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE)
+		return NULL;
+
+	for (p = 0; p < PREFILL_PATTERN_NUMS; p++) {
+		if (ucPrefillPattern[p] == ucPattern)
+			break;
+	}
+	if (p == PREFILL_PATTERN_NUMS)
+		return NULL;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+	for (i = 0; i < CONFIG_HEAP_PREFILL_POOL_SLOTS; i++) {
+		pxSlot = &xPrefillPool[p][i];
+		if (pxSlot->ucState == PREFILL_SLOT_READY) {
+			pvReturn = pxSlot->pucBuf;
+			pxSlot->pucBuf = NULL;
+			pxSlot->xFilled = 0;
+			pxSlot->ucState = PREFILL_SLOT_EMPTY;
+			break;
+		}
+	}
+
+	if (pvReturn) {
+		pxBlock = (BlockLink_t *)(((uint8_t *)pvReturn) - xHeapStructSize);
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+		/* The block now belongs to the caller, not to the idle task */
+		vPortRmFromList((size_t)pxBlock);
+#endif
+		/* The trace has the block as allocated by the idle task, end that
+		   before recording it again for the caller */
+		vPortAllocTraceRecord(ALLOC_TRACE_FREE, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit, 0);
+		prvPrefillTrimBlock(pxBlock, xWantedSize);
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+		vPortAddToList((size_t)pxBlock, xWantedSize);
+#endif
+		traceMALLOC(pvReturn, xWantedSize);
+		vPortAllocTraceRecord(ALLOC_TRACE_MALLOC, pvReturn, xWantedSize, 0);
+	}
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+
+	return pvReturn;
+}
+
+/* Called from the idle task, fills at most one slice per call. */
+void vPortPrefillPoolStep(void)
+{
+	struct prefill_slot *pxSlot = NULL;
+	unsigned long flags;
+	size_t xLen;
+	int i, p;
+
+	for (p = 0; p < PREFILL_PATTERN_NUMS; p++) {
+		for (i = 0; i < CONFIG_HEAP_PREFILL_POOL_SLOTS; i++) {
+			if (xPrefillPool[p][i].ucState != PREFILL_SLOT_READY) {
+				pxSlot = &xPrefillPool[p][i];
+				goto slot_found;
+			}
+		}
+	}
+	return;
+
+slot_found:
+
+	if (pxSlot->ucState == PREFILL_SLOT_EMPTY) {
+		/* A fragmented heap may have the free bytes but no block that fits,
+		   check first so the idle task does not fail an allocation on every
+		   pass. prvHeapMalloc() does not call the malloc failed hook */
+		if (xFreeBytesRemaining < PREFILL_MIN_FREE_BYTES ||
+		    prvPrefillLargestFreeBlock() < prvPrefillBlockSize(CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE))
+			return;
+		pxSlot->pucBuf = prvHeapMalloc(CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE);
+		if (!pxSlot->pucBuf)
+			return;
+		pxSlot->xFilled = 0;
+		pxSlot->ucState = PREFILL_SLOT_FILLING;
+	}
+
+	/* Only the idle task touches a filling slot, no lock needed for the fill */
+	xLen = CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE - pxSlot->xFilled;
+	if (xLen > CONFIG_HEAP_PREFILL_POOL_SLICE)
+		xLen = CONFIG_HEAP_PREFILL_POOL_SLICE;
+	memset(pxSlot->pucBuf + pxSlot->xFilled, ucPrefillPattern[p], xLen);
+	pxSlot->xFilled += xLen;
+
+	if (pxSlot->xFilled == CONFIG_HEAP_PREFILL_POOL_BLOCK_SIZE) {
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+		portIRQ_SAVE(flags);
+#else
+		vTaskSuspendAll();
+#endif
+		pxSlot->ucState = PREFILL_SLOT_READY;
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+		portIRQ_RESTORE(flags);
+#else
+		(void)xTaskResumeAll();
+#endif
+	}
+}
+
+/* Return the ready blocks to the heap, slots being filled are left alone.
+   pvPortMalloc() calls it before failing. Returns the number of blocks
+   returned. */
+size_t xPortPrefillPoolDrain(void)
+{
+	void *pvBuf;
+	unsigned long flags;
+	size_t xDrained = 0;
+	int i, p;
+
+	for (p = 0; p < PREFILL_PATTERN_NUMS; p++) {
+		for (i = 0; i < CONFIG_HEAP_PREFILL_POOL_SLOTS; i++) {
+			pvBuf = NULL;
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+			portIRQ_SAVE(flags);
+#else
+			vTaskSuspendAll();
+#endif
+			if (xPrefillPool[p][i].ucState == PREFILL_SLOT_READY) {
+				pvBuf = xPrefillPool[p][i].pucBuf;
+				xPrefillPool[p][i].pucBuf = NULL;
+				xPrefillPool[p][i].xFilled = 0;
+				xPrefillPool[p][i].ucState = PREFILL_SLOT_EMPTY;
+			}
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+			portIRQ_RESTORE(flags);
+#else
+			(void)xTaskResumeAll();
+#endif
+			if (pvBuf) {
+				vPortFree(pvBuf);
+				xDrained++;
+			}
+		}
+	}
+
+	return xDrained;
+}
+#else
+#define prvPrefillTake(xWantedSize, ucPattern) NULL
+#endif
+
+void *pvPortMallocFilled(size_t xWantedSize, uint8_t ucPattern)
+{
+	void *p;
+
+	p = prvPrefillTake(xWantedSize, ucPattern);
+	if (p)
+		return p;
+
+	p = pvPortMalloc(xWantedSize);
+	if (p)
+		memset(p, ucPattern, xWantedSize);
+
+	return p;
+}
+
+void *pvPortCalloc(size_t xNum, size_t xSize)
+{
+	if (xSize && xNum > ((size_t)-1) / xSize)
+		return NULL;
+
+	return pvPortMallocFilled(xNum * xSize, 0);
+}
+
 void *xPortRealloc(void *ptr, size_t size)
 {
 	void *p = NULL;
@@ -31,7 +304,9 @@ void *xPortRealloc(void *ptr, size_t size)
 	if (ptr)
 	{
 		BlockLink_t *pxTmp = (BlockLink_t *)(((uint8_t *)ptr) - xHeapStructSize);
-		old_len = pxTmp->xBlockSize - xHeapStructSize;
+
+		vPortAllocTraceRecord(ALLOC_TRACE_REALLOC, ptr, size, 0);
+		old_len = (pxTmp->xBlockSize & ~xBlockAllocatedBit) - xHeapStructSize;
 		len = old_len < size ? old_len : size;
 		if (!size)
 		{
@@ -39,12 +314,21 @@ void *xPortRealloc(void *ptr, size_t size)
 			return NULL;
 		}
 
-		p = pvPortMalloc(size);
+		/* A zeroed block from the pool saves clearing the growth region */
+		p = prvPrefillTake(size, 0);
 		if (p)
 		{
 			memcpy(p, ptr, len);
-			if (size > len)
-				memset((char *)p + len, 0, size - len);
+		}
+		else
+		{
+			p = pvPortMalloc(size);
+			if (p)
+			{
+				memcpy(p, ptr, len);
+				if (size > len)
+					memset((char *)p + len, 0, size - len);
+			}
 		}
 		vPortFree(ptr);
 	}
@@ -8,9 +8,19 @@
 #define __AML_HEAP_5_EXT_H__
 
 #include <stddef.h>
+#include <stdint.h>
 
 int vPrintFreeListAfterMallocFail(void);
 
 void *xPortRealloc(void *ptr, size_t size);
 
+void *pvPortCalloc(size_t xNum, size_t xSize);
+
+void *pvPortMallocFilled(size_t xWantedSize, uint8_t ucPattern);
+
+#ifdef CONFIG_HEAP_PREFILL_POOL
+void vPortPrefillPoolStep(void);
+size_t xPortPrefillPoolDrain(void);
+#endif
+
 #endif
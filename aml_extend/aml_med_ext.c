@@ -4,14 +4,6 @@
  * SPDX-License-Identifier: MIT
  */
 
-#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
-#include "printk.h"
-#if CONFIG_BACKTRACE
-#include "stack_trace.h"
-#endif
-#endif
-
-#define UNWIND_DEPTH 5
 #define RAM_REGION_NUMS 2
 #define HEAD_CANARY_PATTERN ((size_t)(0x5051525354555657))
 #define TAIL_CANARY_PATTERN ((size_t)(0x6061626364656667))
@@ -19,12 +11,6 @@
 #define TAIL_CANARY(x, y) \
 	(*(size_t *)((size_t)(x) + ((y) & ~xBlockAllocatedBit) - sizeof(size_t)))
 
-#ifdef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
-#define DEBUG_PRINT(...)
-#else
-#define DEBUG_PRINT(...) printk(__VA_ARGS__)
-#endif
-
 /* Used to define the bss and data segments in the program. */
 struct tmemory_region {
 	size_t *startAddress;
@@ -43,6 +29,32 @@ struct alloc_trace_block {
 /* allocation buffer pool tracking alloc */
 struct alloc_trace_block allocList[CONFIG_MEMORY_ERROR_DETECTION_SIZE] = {NULL};
 
+/* Leak scan state, see xPortMemoryScanStep */
+#define SCAN_PHASE_IDLE 0
+#define SCAN_PHASE_STATIC 1
+#define SCAN_PHASE_DYNAMIC 2
+#define SCAN_PHASE_NEW 3
+#define SCAN_PHASE_REPORT 4
+
+#define SCAN_MARK_INDEXED 0x1
+#define SCAN_MARK_REFERENCED 0x2
+
+struct leak_scan_item {
+	size_t start;
+	uint32_t pos;
+};
+
+struct leak_scan_state {
+	int phase;
+	size_t nums;
+	size_t item;
+	size_t *cursor;
+	struct leak_scan_item index[CONFIG_MEMORY_ERROR_DETECTION_SIZE];
+	uint8_t mark[CONFIG_MEMORY_ERROR_DETECTION_SIZE];
+};
+
+static struct leak_scan_state leakScan;
+
 #if CONFIG_N200_REVA
 // NOTHING
 #else
@@ -54,34 +66,6 @@ struct tmemory_region globalRam[RAM_REGION_NUMS] = {
 	{(size_t *)_bss_start, (size_t)_bss_len}, {(size_t *)_data_start, (size_t)_data_len}};
 #endif
 
-/* For pinpointing the location of anomalies(dump stack) */
-// print_traceitem
-static void print_traceitem(unsigned long *trace)
-{
-#if CONFIG_BACKTRACE
-	DEBUG_PRINT("\tCallTrace:\n");
-	for (int i = 0; i < UNWIND_DEPTH; i++) {
-		DEBUG_PRINT("\t");
-#ifndef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
-		print_symbol(*(trace + i));
-#endif
-	}
-#endif
-}
-// get_calltrace
-static void get_calltrace(unsigned long *trace)
-{
-#if CONFIG_BACKTRACE
-#define CT_SKIP 2
-	int32_t ret, i;
-	unsigned long _trace[32];
-
-	ret = get_backtrace(NULL, _trace, UNWIND_DEPTH + CT_SKIP);
-	if (ret)
-		for (i = 0; i < UNWIND_DEPTH; i++)
-			trace[i] = _trace[i + CT_SKIP];
-#endif
-}
 // On-site printing from memory
 #ifdef CONFIG_MEMORY_ERROR_DETECTION_PRINT
 static void print_memory_site_info(uint8_t *address)
@@ -213,46 +197,6 @@ static void printMemoryLeakSite(size_t pos, size_t allocatedAddress)
 	print_traceitem(allocList[pos].backTrace);
 }
 
-// scan dynamic memory is leak?
-static int xScanDynamicMemory(size_t pos, size_t allocatedAddress)
-{
-	size_t *eAdd, *sAdd;
-
-	for (size_t idx = 0; idx < CONFIG_MEMORY_ERROR_DETECTION_SIZE; idx++) {
-		if ((pos != idx) && (allocList[idx].allocHandle)) {
-			/* Calculate the current thread stack address range */
-			sAdd = (size_t *)(xHeapStructSize +
-					  (size_t)(allocList[idx].allocHandle));
-			eAdd = (size_t *)(allocList[idx].requestSize + (size_t)sAdd);
-			/* scan the current memory block */
-			for (; sAdd < eAdd; sAdd++) {
-				if (*sAdd == allocatedAddress)
-					return 1;
-			}
-		}
-	}
-	return 0;
-}
-// Scan static memory blocks
-static int xScanStaticMemory(size_t allocatedAddress)
-{
-	size_t *eAdd, *sAdd;
-	size_t *jumpSAdd = (size_t *)(&allocList[0]);
-	size_t *jumpEAdd = (size_t *)((size_t)jumpSAdd + sizeof(allocList));
-
-	for (int i = 0; i < RAM_REGION_NUMS; i++) {
-		/* Calculate the address range of the static memory area */
-		sAdd = globalRam[i].startAddress;
-		eAdd = (size_t *)((size_t)(sAdd) + globalRam[i].size);
-		/* scan bss & data segment */
-		for (; sAdd < eAdd; sAdd++) {
-			if ((*sAdd == allocatedAddress) &&
-			    ((sAdd < jumpSAdd) || (sAdd > jumpEAdd)))
-				return 1;
-		}
-	}
-	return 0;
-}
 /****************************************************************/
 // vPortAddToList
 static void vPortAddToList(size_t pointer, size_t tureSize)
@@ -270,6 +214,8 @@ static void vPortAddToList(size_t pointer, size_t tureSize)
 			allocList[pos].blockSize = temp->xBlockSize;
 			/* mount malloc point */
 			allocList[pos].allocHandle = (BlockLink_t *)pointer;
+			/* a scan in progress may have indexed the old block */
+			leakScan.mark[pos] = 0;
 			/* get call stack info */
 			get_calltrace(allocList[pos].backTrace);
 			/* Current task owener */
@@ -378,41 +324,367 @@ int xPortCheckIntegrity(void)
 	return result;
 }
 
-// Check for orphaned memory(memleak detection)
-int xPortMemoryScan(void)
+/*
+ * Incremental integrity check. Each step checks at most a budget of blocks
+ * and resumes where the previous step stopped: first the free list (head
+ * canary, address order, overlap), then the tracked allocations (head and
+ * tail canary). Problems are reported to the registered callback.
+ */
+#define CHECK_PHASE_FREE_LIST 0
+#define CHECK_PHASE_ALLOC_LIST 1
+
+static struct {
+	int phase;
+	int result;
+	size_t cursor;
+	BlockLink_t *freeCursor;
+	med_corruption_cb callback;
+} integrityCheck;
+
+// vPortSetIntegrityCallback
+void vPortSetIntegrityCallback(med_corruption_cb callback)
 {
-	int result = 0;
-	size_t found, allocatedAddress;
+	integrityCheck.callback = callback;
+}
+// vIntegrityReport
+static void vIntegrityReport(void *block, int kind)
+{
+	integrityCheck.result++;
+	if (integrityCheck.callback)
+		integrityCheck.callback(block, kind);
+}
+// vIntegrityCheckUnlink
+/*
+ * Called by the allocator when block leaves the free list, either allocated
+ * or merged, with the free block that now precedes its successor, so the
+ * free list cursor always stays on the list.
+ */
+static void vIntegrityCheckUnlink(BlockLink_t *block, BlockLink_t *replacement)
+{
+	if (integrityCheck.freeCursor == block)
+		integrityCheck.freeCursor = replacement;
+}
+// xIntegrityCheckFreeList
+static size_t xIntegrityCheckFreeList(size_t budget)
+{
+	/* Resume after the last block checked, which is still on the list */
+	BlockLink_t *prev = integrityCheck.freeCursor ? integrityCheck.freeCursor : &xStart;
+	BlockLink_t *block = prev->pxNextFreeBlock;
+
+	while (block != pxEnd && budget) {
+		/* xStart is not in any region, only blocks within them are ordered */
+		if (block == NULL || (prev != &xStart && (block <= prev ||
+		    (uint8_t *)prev + prev->xBlockSize > (uint8_t *)block))) {
+			DEBUG_PRINT("ERROR!!! free list broken after %p\r\n", prev);
+			vIntegrityReport(prev, MED_CORRUPT_FREE_LIST);
+			/* Cannot walk any further */
+			break;
+		}
+		if (HEAD_CANARY(block) != HEAD_CANARY_PATTERN ||
+		    (block->xBlockSize & xBlockAllocatedBit)) {
+			DEBUG_PRINT("ERROR!!! free block %p corrupted\r\n", block);
+			vIntegrityReport(block, MED_CORRUPT_FREE_LIST);
+		}
+		integrityCheck.freeCursor = block;
+		prev = block;
+		block = block->pxNextFreeBlock;
+		budget--;
+	}
 
-	/* memory leak scan */
-	for (size_t pos = 0; pos < CONFIG_MEMORY_ERROR_DETECTION_SIZE; pos++) {
-		/* Scan the specified memory mount point */
+	if (block == pxEnd || budget) {
+		integrityCheck.freeCursor = NULL;
+		integrityCheck.phase = CHECK_PHASE_ALLOC_LIST;
+	}
+	return budget;
+}
+// xIntegrityCheckAllocList
+static size_t xIntegrityCheckAllocList(size_t budget)
+{
+	BlockLink_t *block;
+
+	while (integrityCheck.cursor < CONFIG_MEMORY_ERROR_DETECTION_SIZE && budget) {
+		block = allocList[integrityCheck.cursor].allocHandle;
+		if (block) {
+			if (HEAD_CANARY(block) != HEAD_CANARY_PATTERN) {
+				xPrintOutOfBoundSite(integrityCheck.cursor);
+				vIntegrityReport((uint8_t *)block + xHeapStructSize, MED_CORRUPT_HEAD);
+			} else if (TAIL_CANARY(block, allocList[integrityCheck.cursor].blockSize) !=
+				   TAIL_CANARY_PATTERN) {
+				xPrintOutOfBoundSite(integrityCheck.cursor);
+				vIntegrityReport((uint8_t *)block + xHeapStructSize, MED_CORRUPT_TAIL);
+			}
+			budget--;
+		}
+		integrityCheck.cursor++;
+	}
+	return budget;
+}
+
+/*
+ * Check at most xBlockBudget blocks (0 means no limit).
+ * Returns -1 while the pass is still running, otherwise the number of
+ * problems found by the pass that just completed.
+ */
+int xPortCheckIntegrityStep(size_t xBlockBudget)
+{
+	unsigned long flags;
+	size_t budget = xBlockBudget ? xBlockBudget : (size_t)-1;
+	int result = -1;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+
+	if (pxEnd) {
+		if (integrityCheck.phase == CHECK_PHASE_FREE_LIST)
+			budget = xIntegrityCheckFreeList(budget);
+		if (integrityCheck.phase == CHECK_PHASE_ALLOC_LIST && budget)
+			budget = xIntegrityCheckAllocList(budget);
+
+		if (integrityCheck.phase == CHECK_PHASE_ALLOC_LIST &&
+		    integrityCheck.cursor >= CONFIG_MEMORY_ERROR_DETECTION_SIZE) {
+			result = integrityCheck.result;
+			integrityCheck.result = 0;
+			integrityCheck.cursor = 0;
+			integrityCheck.phase = CHECK_PHASE_FREE_LIST;
+		}
+	}
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+
+	return result;
+}
+
+/*
+ * Leak scan. Every live block in allocList is put in an address-sorted
+ * index, then each word of .bss/.data and of every live block is read once
+ * and looked up with a binary search. A word pointing anywhere inside
+ * another block marks that block referenced. Blocks nobody points to are
+ * reported. The scan can be split into steps with a word budget each.
+ */
+// xLeakScanIsLive
+static int xLeakScanIsLive(struct leak_scan_item *item)
+{
+	return allocList[item->pos].allocHandle ==
+	       (BlockLink_t *)(item->start - xHeapStructSize);
+}
+// vLeakScanBuildIndex
+static void vLeakScanBuildIndex(void)
+{
+	struct leak_scan_item tmp;
+	size_t pos, gap, i, j;
+
+	leakScan.nums = 0;
+	memset(leakScan.mark, 0, sizeof(leakScan.mark));
+	for (pos = 0; pos < CONFIG_MEMORY_ERROR_DETECTION_SIZE; pos++) {
 		if (allocList[pos].allocHandle) {
-			/* update found mark */
-			found = 0;
-			/* Set target address */
-			allocatedAddress = (size_t)(allocList[pos].allocHandle);
-			allocatedAddress += xHeapStructSize;
-			/* Scan all dynamic memory -1 */
-			found = xScanDynamicMemory(pos, allocatedAddress);
-
-			/* Scan all static memory -2 */
+			leakScan.index[leakScan.nums].start =
+			    (size_t)(allocList[pos].allocHandle) + xHeapStructSize;
+			leakScan.index[leakScan.nums].pos = pos;
+			leakScan.mark[pos] = SCAN_MARK_INDEXED;
+			leakScan.nums++;
+		}
+	}
+
+	/* shell sort by block address */
+	for (gap = leakScan.nums / 2; gap > 0; gap /= 2) {
+		for (i = gap; i < leakScan.nums; i++) {
+			tmp = leakScan.index[i];
+			for (j = i; j >= gap && leakScan.index[j - gap].start > tmp.start; j -= gap)
+				leakScan.index[j] = leakScan.index[j - gap];
+			leakScan.index[j] = tmp;
+		}
+	}
+}
+// vLeakScanMarkWord
+static void vLeakScanMarkWord(size_t value, size_t self)
+{
+	size_t lo = 0, hi = leakScan.nums, mid;
+	struct leak_scan_item *item;
+
+	/* Find the last block starting at or below value */
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (leakScan.index[mid].start <= value)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (!lo)
+		return;
+
+	item = &leakScan.index[lo - 1];
+	if (item->start == self || !xLeakScanIsLive(item))
+		return;
+
+	/* Interior pointers count as references */
+	if (value < item->start + allocList[item->pos].requestSize)
+		leakScan.mark[item->pos] |= SCAN_MARK_REFERENCED;
+}
+// xLeakScanRange
+static size_t xLeakScanRange(size_t *end, size_t self, size_t budget)
+{
+	size_t *skipSAdd = (size_t *)(&allocList[0]);
+	size_t *skipEAdd = (size_t *)((size_t)skipSAdd + sizeof(allocList));
+	size_t *selfSAdd = (size_t *)(&leakScan);
+	size_t *selfEAdd = (size_t *)((size_t)selfSAdd + sizeof(leakScan));
+
+	while (leakScan.cursor < end && budget) {
+		/* Tracking tables hold every block address, do not count them */
+		if (leakScan.cursor >= skipSAdd && leakScan.cursor < skipEAdd) {
+			leakScan.cursor = skipEAdd;
+			continue;
+		}
+		if (leakScan.cursor >= selfSAdd && leakScan.cursor < selfEAdd) {
+			leakScan.cursor = selfEAdd;
+			continue;
+		}
+		vLeakScanMarkWord(*leakScan.cursor, self);
+		leakScan.cursor++;
+		budget--;
+	}
+	return budget;
+}
+// xLeakScanBlock
+static size_t xLeakScanBlock(uint32_t pos, size_t budget)
+{
+	size_t start = (size_t)(allocList[pos].allocHandle) + xHeapStructSize;
+	size_t *end = (size_t *)(start + allocList[pos].requestSize);
+
+	if (!leakScan.cursor)
+		leakScan.cursor = (size_t *)start;
+	budget = xLeakScanRange(end, start, budget);
+	if (leakScan.cursor >= end) {
+		leakScan.cursor = NULL;
+		leakScan.item++;
+	}
+	return budget;
+}
+// xLeakScanReport
+static int xLeakScanReport(void)
+{
+	struct leak_scan_item *item;
+	int result = 0;
+
+	for (size_t i = 0; i < leakScan.nums; i++) {
+		item = &leakScan.index[i];
+		/* A slot reused during the pass is left to the next pass */
+		if (xLeakScanIsLive(item) &&
+		    (leakScan.mark[item->pos] & (SCAN_MARK_INDEXED | SCAN_MARK_REFERENCED)) ==
+			    SCAN_MARK_INDEXED) {
+			printMemoryLeakSite(item->pos, item->start);
+			result++;
+		}
+	}
+	return result;
+}
+
+/*
+ * Run the leak scan for at most xWordBudget words (0 means no limit).
+ * Returns -1 while the pass is still running, otherwise the number of
+ * leaked blocks found by the pass that just completed. Blocks allocated
+ * during a pass are scanned but only reported by the next pass.
+ */
+int xPortMemoryScanStep(size_t xWordBudget)
+{
+	unsigned long flags;
+	size_t budget = xWordBudget ? xWordBudget : (size_t)-1;
+	int result = -1;
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_SAVE(flags);
+#else
+	vTaskSuspendAll();
+#endif
+
+	if (leakScan.phase == SCAN_PHASE_IDLE) {
+		vLeakScanBuildIndex();
+		leakScan.item = 0;
+		leakScan.cursor = NULL;
+		leakScan.phase = SCAN_PHASE_STATIC;
+	}
+
+	/* Scan all static memory -1 */
+	while (leakScan.phase == SCAN_PHASE_STATIC && budget) {
 #ifndef CONFIG_N200_REVA
-			if (!found)
-				found = xScanStaticMemory(allocatedAddress);
+		if (leakScan.item < RAM_REGION_NUMS) {
+			size_t *end = (size_t *)((size_t)(globalRam[leakScan.item].startAddress) +
+						 globalRam[leakScan.item].size);
+
+			if (!leakScan.cursor)
+				leakScan.cursor = globalRam[leakScan.item].startAddress;
+			budget = xLeakScanRange(end, 0, budget);
+			if (leakScan.cursor >= end) {
+				leakScan.cursor = NULL;
+				leakScan.item++;
+			}
+			continue;
+		}
 #endif
+		leakScan.item = 0;
+		leakScan.cursor = NULL;
+		leakScan.phase = SCAN_PHASE_DYNAMIC;
+	}
 
-			/* Didn't found any references to a pointer -3 */
-			if (!found) {
-				printMemoryLeakSite(pos, allocatedAddress);
-				result++;
+	/* Scan all dynamic memory -2 */
+	while (leakScan.phase == SCAN_PHASE_DYNAMIC && budget) {
+		if (leakScan.item < leakScan.nums) {
+			if (xLeakScanIsLive(&leakScan.index[leakScan.item])) {
+				budget = xLeakScanBlock(leakScan.index[leakScan.item].pos, budget);
+			} else {
+				leakScan.cursor = NULL;
+				leakScan.item++;
 			}
+			continue;
 		}
+		leakScan.item = 0;
+		leakScan.cursor = NULL;
+		leakScan.phase = SCAN_PHASE_NEW;
 	}
 
+	/* Blocks allocated since the index was built may hold references too */
+	while (leakScan.phase == SCAN_PHASE_NEW && budget) {
+		if (leakScan.item < CONFIG_MEMORY_ERROR_DETECTION_SIZE) {
+			if (allocList[leakScan.item].allocHandle &&
+			    !(leakScan.mark[leakScan.item] & SCAN_MARK_INDEXED)) {
+				budget = xLeakScanBlock(leakScan.item, budget);
+			} else {
+				leakScan.cursor = NULL;
+				leakScan.item++;
+			}
+			continue;
+		}
+		leakScan.phase = SCAN_PHASE_REPORT;
+	}
+
+	/* Didn't found any references to a pointer -3 */
+	if (leakScan.phase == SCAN_PHASE_REPORT) {
+		result = xLeakScanReport();
+		leakScan.phase = SCAN_PHASE_IDLE;
+	}
+
+#if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
+	portIRQ_RESTORE(flags);
+#else
+	(void)xTaskResumeAll();
+#endif
+
 	return result;
 }
 
+// Check for orphaned memory(memleak detection)
+int xPortMemoryScan(void)
+{
+	/* Without a budget the pass always completes */
+	return xPortMemoryScanStep(0);
+}
+
 /************************* MED Benchmarks **************************/
 #ifdef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
 
@@ -7,12 +7,29 @@
 #ifndef __AML_MED_EXT_H__
 #define __AML_MED_EXT_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef CONFIG_MEMORY_ERROR_DETECTION
+/* Kind of corruption passed to med_corruption_cb */
+#define MED_CORRUPT_FREE_LIST 0
+#define MED_CORRUPT_HEAD 1
+#define MED_CORRUPT_TAIL 2
+
+typedef void (*med_corruption_cb)(void *block, int kind);
+
 int xCheckMallocNodeIsOver(void *node);
 int xPortCheckIntegrity(void);
+int xPortCheckIntegrityStep(size_t xBlockBudget);
+void vPortSetIntegrityCallback(med_corruption_cb callback);
+/*
+ * Leak scan: a block is reported when no word of .bss/.data or of another
+ * live block points into it. The scan is not transitive, a block referenced
+ * only from a leaked block is not reported. xWordBudget bounds the number
+ * of words read per step, not the time spent in it.
+ */
 int xPortMemoryScan(void);
+int xPortMemoryScanStep(size_t xWordBudget);
 #ifdef CONFIG_MEMORY_ERROR_DETECTION_BENCHMARKS
 void med_benchmarks(uint32_t nodeNums);
 #endif
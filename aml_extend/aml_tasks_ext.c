@@ -108,6 +108,14 @@ void *pvGetTaskHandleOfNum(uint32_t tasknum)
 		if (pxFirstTCB)
 			goto GetTaskHandleOfNumExit;
 	} while (uxQueue > (UBaseType_t)tskIDLE_PRIORITY);
+#if (configUSE_PARTITIONS == 1)
+	for (uxQueue = 0; uxQueue < configNUM_PARTITIONS; uxQueue++) {
+		pxFirstTCB =
+		    prvFindTasksWithinSingleList(&(xPartitionReadyLists[uxQueue]), tasknum);
+		if (pxFirstTCB)
+			goto GetTaskHandleOfNumExit;
+	}
+#endif
 	pxFirstTCB = prvFindTasksWithinSingleList((List_t *)pxDelayedTaskList, tasknum);
 	if (pxFirstTCB)
 		goto GetTaskHandleOfNumExit;
@@ -147,6 +155,11 @@ void xIterateOverAllThreads(void (*process_task_list)(List_t *list))
 		process_task_list(&pxReadyTasksLists[queue]);
 	} while (queue > tskIDLE_PRIORITY);
 
+#if (configUSE_PARTITIONS == 1)
+	for (queue = 0; queue < configNUM_PARTITIONS; queue++)
+		process_task_list(&xPartitionReadyLists[queue]);
+#endif
+
 	process_task_list((List_t *)pxDelayedTaskList);
 	process_task_list((List_t *)pxOverflowDelayedTaskList);
 
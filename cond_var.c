@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "cond_var.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_MUTEXES == 1 )
+
+/* Waiting tasks are only ever moved off xTasksWaiting by other tasks, or by
+the tick interrupt when they time out, so the list is accessed with the
+scheduler suspended rather than with interrupts masked. */
+typedef struct CondVarDef_t
+{
+	SemaphoreHandle_t xMutex;			/*< The mutex the condition variable is bound to. */
+	List_t xTasksWaiting;				/*< Tasks blocked in xCondVarWait(), in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the condition variable is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} CondVar_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a condition variable that has been allocated.
+ */
+static void prvInitialiseCondVar( CondVar_t * const pxCondVar, SemaphoreHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	CondVarHandle_t xCondVarCreateStatic( SemaphoreHandle_t xMutex, StaticCondVar_t *pxCondVarBuffer )
+	{
+	CondVar_t *pxCondVar;
+
+		configASSERT( pxCondVarBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticCondVar_t equals the size of the real
+			condition variable structure. */
+			volatile size_t xSize = sizeof( StaticCondVar_t );
+			configASSERT( xSize == sizeof( CondVar_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxCondVar = ( CondVar_t * ) pxCondVarBuffer; /*lint !e740 !e9087 CondVar_t and StaticCondVar_t are deliberately aliased for data hiding purposes. */
+
+		if( pxCondVar != NULL )
+		{
+			prvInitialiseCondVar( pxCondVar, xMutex );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxCondVar->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceCOND_VAR_CREATE( pxCondVar );
+		}
+		else
+		{
+			traceCOND_VAR_CREATE_FAILED();
+		}
+
+		return pxCondVar;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	CondVarHandle_t xCondVarCreate( SemaphoreHandle_t xMutex )
+	{
+	CondVar_t *pxCondVar;
+
+		pxCondVar = ( CondVar_t * ) pvPortMalloc( sizeof( CondVar_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxCondVar != NULL )
+		{
+			prvInitialiseCondVar( pxCondVar, xMutex );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxCondVar->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceCOND_VAR_CREATE( pxCondVar );
+		}
+		else
+		{
+			traceCOND_VAR_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxCondVar;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseCondVar( CondVar_t * const pxCondVar, SemaphoreHandle_t xMutex )
+{
+	configASSERT( xMutex );
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		/* Recursive mutexes are not supported. */
+		configASSERT( ucQueueGetQueueType( xMutex ) == queueQUEUE_TYPE_MUTEX );
+	}
+	#endif
+
+	pxCondVar->xMutex = xMutex;
+	vListInitialise( &( pxCondVar->xTasksWaiting ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCondVarWait( CondVarHandle_t xCondVar, TickType_t xTicksToWait )
+{
+CondVar_t * const pxCondVar = xCondVar;
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	configASSERT( pxCondVar );
+
+	#if ( INCLUDE_xSemaphoreGetMutexHolder == 1 )
+	{
+		/* The mutex must be held to wait on the condition variable. */
+		configASSERT( xSemaphoreGetMutexHolder( pxCondVar->xMutex ) == xTaskGetCurrentTaskHandle() );
+	}
+	#endif
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskInternalSetTimeOutState( &xTimeOut );
+
+		/* With the scheduler suspended no other task can take the mutex, and
+		so signal the condition variable, between the mutex being given and
+		this task being on the list of waiting tasks.  The mutex is given
+		first as giving it may disinherit a priority, which expects the task
+		to still be ready. */
+		vTaskSuspendAll();
+		{
+			( void ) xSemaphoreGive( pxCondVar->xMutex );
+
+			traceBLOCKING_ON_COND_VAR_WAIT( pxCondVar );
+			vTaskPlaceOnEventList( &( pxCondVar->xTasksWaiting ), xTicksToWait );
+		}
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A signalled task is moved to wait for the mutex, and is unblocked
+		when the mutex is given to it.  A task that was not moved was unblocked
+		by its block time expiring. */
+		if( xTaskMovedToMutex() != pdFALSE )
+		{
+			xReturn = pdTRUE;
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time expired while the task waited for the mutex,
+				which it still has to take. */
+				vQueueDisinheritAfterTimeoutRestricted( pxCondVar->xMutex );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		/* Usually the mutex is free now, but a higher priority task may have
+		taken it first. */
+		while( xSemaphoreTake( pxCondVar->xMutex, portMAX_DELAY ) == pdFALSE )
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	if( xReturn != pdFALSE )
+	{
+		traceCOND_VAR_WAIT( pxCondVar );
+	}
+	else
+	{
+		traceCOND_VAR_WAIT_FAILED( pxCondVar );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vCondVarSignal( CondVarHandle_t xCondVar )
+{
+CondVar_t * const pxCondVar = xCondVar;
+
+	configASSERT( pxCondVar );
+
+	traceCOND_VAR_SIGNAL( pxCondVar );
+
+	vTaskSuspendAll();
+	{
+		vQueueMoveToMutexRestricted( pxCondVar->xMutex, &( pxCondVar->xTasksWaiting ), pdFALSE );
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vCondVarBroadcast( CondVarHandle_t xCondVar )
+{
+CondVar_t * const pxCondVar = xCondVar;
+
+	configASSERT( pxCondVar );
+
+	traceCOND_VAR_BROADCAST( pxCondVar );
+
+	vTaskSuspendAll();
+	{
+		vQueueMoveToMutexRestricted( pxCondVar->xMutex, &( pxCondVar->xTasksWaiting ), pdTRUE );
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vCondVarDelete( CondVarHandle_t xCondVar )
+{
+CondVar_t * const pxCondVar = xCondVar;
+
+	configASSERT( pxCondVar );
+	configASSERT( listLIST_IS_EMPTY( &( pxCondVar->xTasksWaiting ) ) != pdFALSE );
+
+	traceCOND_VAR_DELETE( pxCondVar );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxCondVar );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxCondVar->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxCondVar );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+
+#endif /* configUSE_MUTEXES */
@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "event_groups.h"
 
+#if( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -53,17 +57,45 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
 	#define eventWAIT_FOR_ALL_BITS			0x0400U
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff00U
+	#define eventNUM_USABLE_BITS			8U
 #else
 	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x01000000UL
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x02000000UL
 	#define eventWAIT_FOR_ALL_BITS			0x04000000UL
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
+	#define eventNUM_USABLE_BITS			24U
+#endif
+
+/* Waiting tasks are indexed by the bits they wait for, so setting bits only
+tests the tasks that wait for one of them.  Each bucket of
+configEVENT_GROUP_WAITER_BUCKET_BITS bits has a list of the tasks that wait only
+for bits within it.  The last list holds the tasks that wait for bits in more
+than one bucket and is tested on every set.  A task is only on a list while its
+wait condition is not met, so a set that does not touch its bits cannot meet
+it. */
+#if( configEVENT_GROUP_WAITER_BUCKET_BITS > 0 )
+	#define eventNUM_WAITER_BUCKETS			( eventNUM_USABLE_BITS / ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKET_BITS )
+	#define eventBUCKET_MASK				( ( EventBits_t ) ( ( 1UL << configEVENT_GROUP_WAITER_BUCKET_BITS ) - 1UL ) )
+	#define eventNUM_WAITING_LISTS			( eventNUM_WAITER_BUCKETS + 1U )
+	#define eventLIST_WAITS_FOR_BITS( uxList, uxBits ) ( ( ( uxList ) == eventNUM_WAITER_BUCKETS ) || ( ( ( ( uxBits ) >> ( ( uxList ) * ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKET_BITS ) ) & eventBUCKET_MASK ) != ( EventBits_t ) 0 ) )
+#else
+	#define eventNUM_WAITING_LISTS			1U
+	#define eventLIST_WAITS_FOR_BITS( uxList, uxBits ) ( pdTRUE )
 #endif
 
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits[ eventNUM_WAITING_LISTS ];	/*< Lists of tasks waiting for a bit to be set, see eventNUM_WAITING_LISTS. */
+
+	#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+		UBaseType_t uxLocked;			/*< Non zero while a task uses xTasksWaitingForBits with the scheduler suspended. */
+		EventBits_t uxBitsSetWhileLocked;	/*< Bits set from interrupts while the event group was locked. */
+	#endif
+
+	#if( configUSE_POLL_SETS == 1 )
+		PollMemberHandle_t xPollMember;	/*< The poll set member the event group is, or NULL. */
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
@@ -86,6 +118,55 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Set uxBitsToSet and unblock the tasks whose wait condition is then met.
+ * Called with the scheduler suspended and the event group locked, or from
+ * xEventGroupSetBitsFromISR() with interrupts masked, in which case xFromISR is
+ * pdTRUE and the return value is pdTRUE if an unblocked task has a priority
+ * above the interrupted task.
+ */
+static BaseType_t prvSetBitsUnblockWaiters( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise the lists of waiting tasks of a new event group.
+ */
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * The list a task that waits for uxBitsToWaitFor is placed on, see
+ * eventNUM_WAITING_LISTS.
+ */
+static List_t *prvGetWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
+
+#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+
+	/*
+	 * The number of tasks prvSetBitsUnblockWaiters() tests when it sets
+	 * uxBitsToSet.
+	 */
+	static UBaseType_t prvCountWaitersForBits( const EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+
+	/*
+	 * Interrupts cannot use the list of waiting tasks while a task does, with
+	 * the scheduler suspended but interrupts enabled.  Instead they leave the
+	 * bits in uxBitsSetWhileLocked, which are set when the event group is
+	 * unlocked.  Both are called with the scheduler suspended.
+	 */
+	static void prvLockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+	static void prvUnlockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/* Interrupts never use the list of waiting tasks. */
+	#define prvLockEventGroup( pxEventBits )
+	#define prvUnlockEventGroup( pxEventBits )
+
+#endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +194,20 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
+
+			#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+			{
+				pxEventBits->uxLocked = 0U;
+				pxEventBits->uxBitsSetWhileLocked = 0;
+			}
+			#endif
+
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				pxEventBits->xPollMember = NULL;
+			}
+			#endif
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -164,7 +258,20 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
+
+			#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+			{
+				pxEventBits->uxLocked = 0U;
+				pxEventBits->uxBitsSetWhileLocked = 0;
+			}
+			#endif
+
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				pxEventBits->xPollMember = NULL;
+			}
+			#endif
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -204,6 +311,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	prvLockEventGroup( pxEventBits );
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -229,7 +337,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -246,6 +354,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	prvUnlockEventGroup( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +436,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	prvLockEventGroup( pxEventBits );
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -384,7 +494,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +504,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	prvUnlockEventGroup( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -518,92 +629,21 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
+	prvLockEventGroup( pxEventBits );
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
-
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
-		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
-
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
-			}
-			else
-			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
-		}
-
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		( void ) prvSetBitsUnblockWaiters( pxEventBits, uxBitsToSet, pdFALSE );
 	}
+	prvUnlockEventGroup( pxEventBits );
 	( void ) xTaskResumeAll();
 
 	return pxEventBits->uxEventBits;
@@ -613,20 +653,31 @@ BaseType_t xMatchFound = pdFALSE;
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+const List_t *pxTasksWaitingForBits;
+UBaseType_t uxList;
 
 	vTaskSuspendAll();
+	prvLockEventGroup( pxEventBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		for( uxList = 0U; uxList < eventNUM_WAITING_LISTS; uxList++ )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being
+				deleted and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
 		}
 
+		/* Nothing waits any more, so this only drops bits an interrupt set
+		while the tasks were unblocked. */
+		prvUnlockEventGroup( pxEventBits );
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -668,6 +719,268 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvSetBitsUnblockWaiters( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+List_t const * pxList;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound = pdFALSE, xHigherPriorityTaskWoken = pdFALSE;
+UBaseType_t uxList;
+
+	#if( configEVENT_GROUP_ISR_MAX_WAITERS == 0 )
+	{
+		( void ) xFromISR;
+	}
+	#endif
+
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
+
+	for( uxList = 0U; uxList < eventNUM_WAITING_LISTS; uxList++ )
+	{
+		/* Only the lists of tasks that wait for one of the bits being set can
+		hold a task to unblock. */
+		if( eventLIST_WAITS_FOR_BITS( uxList, uxBitsToSet ) != pdFALSE )
+		{
+			pxList = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+			pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+
+			/* See if the new bit value should unblock any tasks. */
+			while( pxListItem != pxListEnd )
+			{
+				pxNext = listGET_NEXT( pxListItem );
+				uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+				xMatchFound = pdFALSE;
+
+				/* Split the bits waited for from the control bits. */
+				uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+				if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+				{
+					/* Just looking for single bit being set. */
+					if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+					{
+						xMatchFound = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+				{
+					/* All bits are set. */
+					xMatchFound = pdTRUE;
+				}
+				else
+				{
+					/* Need all bits to be set, but not all the bits were set. */
+				}
+
+				if( xMatchFound != pdFALSE )
+				{
+					/* The bits match.  Should the bits be cleared on exit? */
+					if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBitsWaitedFor;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Store the actual event flag value in the task's event list
+					item before removing the task from the event list.  The
+					eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+					that is was unblocked due to its required bits matching, rather
+					than because it timed out. */
+					#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+					if( xFromISR != pdFALSE )
+					{
+						if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+						{
+							xHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					#endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
+					{
+						vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+
+				/* Move onto the next list item.  Note pxListItem->pxNext is not
+				used here as the list item may have been removed from the event list
+				and inserted into the ready/pending reading list. */
+				pxListItem = pxNext;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		if( pxEventBits->xPollMember != NULL )
+		{
+			/* A poll set must be told with interrupts masked. */
+			if( xFromISR != pdFALSE )
+			{
+				if( xPollSetSignal( pxEventBits->xPollMember, uxBitsToSet ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The scheduler is suspended, so a task unblocked here is
+				switched to when it is resumed. */
+				taskENTER_CRITICAL();
+				{
+					( void ) xPollSetSignal( pxEventBits->xPollMember, uxBitsToSet );
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_POLL_SETS */
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits )
+{
+UBaseType_t uxList;
+
+	for( uxList = 0U; uxList < eventNUM_WAITING_LISTS; uxList++ )
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static List_t *prvGetWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor )
+{
+UBaseType_t uxList = 0U;
+
+	#if( configEVENT_GROUP_WAITER_BUCKET_BITS > 0 )
+	{
+		/* Find the bucket that holds all the bits.  If there is none uxList
+		ends up at the list of tasks that wait across buckets. */
+		while( uxList < eventNUM_WAITER_BUCKETS )
+		{
+			if( ( uxBitsToWaitFor & ~( eventBUCKET_MASK << ( uxList * ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKET_BITS ) ) ) == ( EventBits_t ) 0 )
+			{
+				break;
+			}
+			else
+			{
+				uxList++;
+			}
+		}
+	}
+	#else
+	{
+		( void ) uxBitsToWaitFor;
+	}
+	#endif /* configEVENT_GROUP_WAITER_BUCKET_BITS */
+
+	return &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+}
+/*-----------------------------------------------------------*/
+
+#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+
+	static void prvLockEventGroup( EventGroup_t *pxEventBits )
+	{
+		taskENTER_CRITICAL();
+		{
+			( pxEventBits->uxLocked )++;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvUnlockEventGroup( EventGroup_t *pxEventBits )
+	{
+	EventBits_t uxBitsSetWhileLocked;
+
+		/* Interrupts can set more bits while earlier ones are being set, so
+		loop until none are left, then unlock in the same critical section. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				uxBitsSetWhileLocked = pxEventBits->uxBitsSetWhileLocked;
+				pxEventBits->uxBitsSetWhileLocked = 0;
+
+				if( uxBitsSetWhileLocked == ( EventBits_t ) 0 )
+				{
+					( pxEventBits->uxLocked )--;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( uxBitsSetWhileLocked == ( EventBits_t ) 0 )
+			{
+				break;
+			}
+
+			traceEVENT_GROUP_SET_BITS( pxEventBits, uxBitsSetWhileLocked );
+			( void ) prvSetBitsUnblockWaiters( pxEventBits, uxBitsSetWhileLocked, pdFALSE );
+		}
+	}
+
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvCountWaitersForBits( const EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet )
+	{
+	UBaseType_t uxList, uxWaiters = 0U;
+
+		for( uxList = 0U; uxList < eventNUM_WAITING_LISTS; uxList++ )
+		{
+			if( eventLIST_WAITS_FOR_BITS( uxList, uxBitsToSet ) != pdFALSE )
+			{
+				uxWaiters += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxWaiters;
+	}
+
+#endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -703,14 +1016,71 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( configEVENT_GROUP_ISR_MAX_WAITERS > 0 ) ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	BaseType_t xReturn;
 
 		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+		#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+		{
+		EventGroup_t *pxEventBits = xEventGroup;
+		UBaseType_t uxSavedInterruptStatus;
+		BaseType_t xDefer = pdFALSE;
+
+			configASSERT( xEventGroup );
+			configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				if( pxEventBits->uxLocked != 0U )
+				{
+					/* The task that holds the lock sets the bits when it
+					unlocks the event group. */
+					pxEventBits->uxBitsSetWhileLocked |= uxBitsToSet;
+				}
+				else if( prvCountWaitersForBits( pxEventBits, uxBitsToSet ) <= ( UBaseType_t ) configEVENT_GROUP_ISR_MAX_WAITERS )
+				{
+					/* Few enough tasks wait to test them all here. */
+					if( prvSetBitsUnblockWaiters( pxEventBits, uxBitsToSet, pdTRUE ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					xDefer = pdTRUE;
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			if( xDefer != pdFALSE )
+			{
+				xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+			}
+			else
+			{
+				xReturn = pdPASS;
+			}
+		}
+		#else
+		{
+			xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+		}
+		#endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
 
 		return xReturn;
 	}
@@ -750,4 +1120,32 @@ BaseType_t xWaitConditionMet = pdFALSE;
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xEventGroupSetPollMember( EventGroupHandle_t xEventGroup, PollMemberHandle_t xMember )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	BaseType_t xReturn;
+
+		configASSERT( xEventGroup );
 
+		taskENTER_CRITICAL();
+		{
+			if( ( xMember != NULL ) && ( pxEventBits->xPollMember != NULL ) )
+			{
+				/* Cannot add an event group to more than one poll set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxEventBits->xPollMember = xMember;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
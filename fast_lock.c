@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "fast_lock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_FAST_LOCKS == 1 )
+
+/* Set in pvOwner while the list of waiting tasks might not be empty, so the
+compare-and-swap in xFastLockGive() fails and the lock is given through the
+kernel.  pvOwner is fastlockWAITERS_BIT alone when the lock is free but tasks
+are still waiting.  Task handles are at least word aligned. */
+#define fastlockWAITERS_BIT				( ( portPOINTER_SIZE_TYPE ) 1U )
+#define fastlockOWNER( pvOwner )		( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pvOwner ) & ~fastlockWAITERS_BIT ) )
+#define fastlockWITH_WAITERS( pvOwner )	( ( void * ) ( ( portPOINTER_SIZE_TYPE ) ( pvOwner ) | fastlockWAITERS_BIT ) )
+
+#if( configUSE_PREEMPTION == 0 )
+	#define fastlockYIELD_IF_USING_PREEMPTION()
+#else
+	#define fastlockYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+typedef struct FastLockDef_t
+{
+	void * volatile pvOwner;			/*< The handle of the task that holds the lock, NULL if the lock is free, see fastlockWAITERS_BIT. */
+	List_t xTasksWaiting;				/*< Tasks blocked waiting for the lock, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} FastLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The part of xFastLockTake() that runs when the lock is held by another task.
+ */
+static BaseType_t prvFastLockTakeContended( FastLock_t * const pxLock, TaskHandle_t const xCurrentTask, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * The priority of the highest priority task waiting for the lock.
+ */
+static UBaseType_t prvFastLockWaitingPriority( const FastLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	FastLockHandle_t xFastLockCreateStatic( StaticFastLock_t *pxFastLockBuffer )
+	{
+	FastLock_t *pxLock;
+
+		configASSERT( pxFastLockBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticFastLock_t equals the size of the real lock
+			structure. */
+			volatile size_t xSize = sizeof( StaticFastLock_t );
+			configASSERT( xSize == sizeof( FastLock_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxLock = ( FastLock_t * ) pxFastLockBuffer; /*lint !e740 !e9087 FastLock_t and StaticFastLock_t are deliberately aliased for data hiding purposes. */
+
+		if( pxLock != NULL )
+		{
+			pxLock->pvOwner = NULL;
+			vListInitialise( &( pxLock->xTasksWaiting ) );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxLock->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceFAST_LOCK_CREATE( pxLock );
+		}
+		else
+		{
+			traceFAST_LOCK_CREATE_FAILED();
+		}
+
+		return pxLock;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	FastLockHandle_t xFastLockCreate( void )
+	{
+	FastLock_t *pxLock;
+
+		pxLock = ( FastLock_t * ) pvPortMalloc( sizeof( FastLock_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxLock != NULL )
+		{
+			pxLock->pvOwner = NULL;
+			vListInitialise( &( pxLock->xTasksWaiting ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxLock->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceFAST_LOCK_CREATE( pxLock );
+		}
+		else
+		{
+			traceFAST_LOCK_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastLockTake( FastLockHandle_t xLock, TickType_t xTicksToWait )
+{
+FastLock_t * const pxLock = xLock;
+TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+BaseType_t xReturn;
+
+	configASSERT( pxLock );
+	configASSERT( xCurrentTask );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* A free lock without waiters is taken with a single compare-and-swap. */
+	if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvOwner ), xCurrentTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+	{
+		/* Counted like a mutex, so an inherited priority is only given back
+		once no mutex or lock is held. */
+		( void ) pvTaskIncrementMutexHeldCount();
+		traceFAST_LOCK_TAKE( pxLock );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		/* The lock is not recursive. */
+		configASSERT( fastlockOWNER( pxLock->pvOwner ) != xCurrentTask );
+
+		xReturn = prvFastLockTakeContended( pxLock, xCurrentTask, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastLockGive( FastLockHandle_t xLock )
+{
+FastLock_t * const pxLock = xLock;
+TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+BaseType_t xYieldRequired = pdFALSE;
+
+	configASSERT( pxLock );
+
+	/* Only the holder can give the lock. */
+	configASSERT( fastlockOWNER( pxLock->pvOwner ) == xCurrentTask );
+
+	traceFAST_LOCK_GIVE( pxLock );
+
+	/* The compare-and-swap only succeeds if no task waits. */
+	if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvOwner ), NULL, xCurrentTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+	{
+		/* Nothing to give back unless a waiter timed out and left an
+		inherited priority behind. */
+		if( xTaskDecrementMutexHeldCount() != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Wake the highest priority waiter, it takes the lock when it
+			runs.  The lock stays off the fast path while tasks still wait. */
+			if( listLIST_IS_EMPTY( &( pxLock->xTasksWaiting ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxLock->xTasksWaiting ) ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( listLIST_IS_EMPTY( &( pxLock->xTasksWaiting ) ) == pdFALSE )
+			{
+				pxLock->pvOwner = fastlockWITH_WAITERS( NULL );
+			}
+			else
+			{
+				pxLock->pvOwner = NULL;
+			}
+
+			if( xTaskPriorityDisinherit( xCurrentTask ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	if( xYieldRequired != pdFALSE )
+	{
+		fastlockYIELD_IF_USING_PREEMPTION();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vFastLockDelete( FastLockHandle_t xLock )
+{
+FastLock_t * const pxLock = xLock;
+
+	configASSERT( pxLock );
+	configASSERT( pxLock->pvOwner == NULL );
+	configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaiting ) ) != pdFALSE );
+
+	traceFAST_LOCK_DELETE( pxLock );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxLock );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxLock );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFastLockTakeContended( FastLock_t * const pxLock, TaskHandle_t const xCurrentTask, TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL, xInheritanceOccurred = pdFALSE, xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+void *pvOwner;
+
+	for( ;; )
+	{
+		/* Locks are not used from interrupts, so with the scheduler suspended
+		no other task can change pvOwner. */
+		vTaskSuspendAll();
+
+		pvOwner = pxLock->pvOwner;
+
+		if( fastlockOWNER( pvOwner ) == NULL )
+		{
+			if( listLIST_IS_EMPTY( &( pxLock->xTasksWaiting ) ) == pdFALSE )
+			{
+				pxLock->pvOwner = fastlockWITH_WAITERS( xCurrentTask );
+			}
+			else
+			{
+				pxLock->pvOwner = xCurrentTask;
+			}
+
+			( void ) pvTaskIncrementMutexHeldCount();
+			( void ) xTaskResumeAll();
+
+			traceFAST_LOCK_TAKE( pxLock );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			traceBLOCKING_ON_FAST_LOCK_TAKE( pxLock );
+
+			/* Make the holder give the lock through the kernel. */
+			pxLock->pvOwner = fastlockWITH_WAITERS( pvOwner );
+
+			taskENTER_CRITICAL();
+			{
+				if( xTaskPriorityInherit( fastlockOWNER( pvOwner ) ) != pdFALSE )
+				{
+					xInheritanceOccurred = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskPlaceOnEventList( &( pxLock->xTasksWaiting ), xTicksToWait );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* Timed out.  This task has already been removed from the list of
+			waiting tasks. */
+			if( xInheritanceOccurred != pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					vTaskPriorityDisinheritAfterTimeout( fastlockOWNER( pvOwner ), prvFastLockWaitingPriority( pxLock ) );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( listLIST_IS_EMPTY( &( pxLock->xTasksWaiting ) ) != pdFALSE )
+			{
+				pxLock->pvOwner = fastlockOWNER( pvOwner );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) xTaskResumeAll();
+
+			traceFAST_LOCK_TAKE_FAILED( pxLock );
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFastLockWaitingPriority( const FastLock_t * const pxLock )
+{
+UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+	if( listCURRENT_LIST_LENGTH( &( pxLock->xTasksWaiting ) ) > 0U )
+	{
+		uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaiting ) );
+	}
+	else
+	{
+		uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+	}
+
+	return uxHighestPriorityOfWaitingTasks;
+}
+
+#endif /* configUSE_FAST_LOCKS */
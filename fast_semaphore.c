@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "fast_semaphore.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* Set in ulCount while the list of waiting tasks might not be empty, so the
+compare-and-swaps in xFastSemaphoreTake() and xFastSemaphoreGive() fail and
+the count is changed through the kernel. */
+#define fastsemaphoreWAITERS_BIT			( ( uint32_t ) 0x80000000UL )
+#define fastsemaphoreCOUNT( ulCount )		( ( ulCount ) & ~fastsemaphoreWAITERS_BIT )
+
+#if( configUSE_PREEMPTION == 0 )
+	#define fastsemaphoreYIELD_IF_USING_PREEMPTION()
+#else
+	#define fastsemaphoreYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+typedef struct FastSemaphoreDef_t
+{
+	volatile uint32_t ulCount;			/*< The count, see fastsemaphoreWAITERS_BIT. */
+	uint32_t ulMaxCount;				/*< The count cannot be given above this. */
+	List_t xTasksWaiting;				/*< Tasks blocked waiting for the count to be above zero, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the semaphore is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} FastSemaphore_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a fast semaphore that has been allocated.
+ */
+static void prvInitialiseFastSemaphore( FastSemaphore_t * const pxSemaphore, UBaseType_t uxMaxCount, UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * The part of xFastSemaphoreTake() that runs when the count is zero or tasks
+ * are waiting.
+ */
+static BaseType_t prvFastSemaphoreTakeContended( FastSemaphore_t * const pxSemaphore, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * The part of xFastSemaphoreGive() that runs when tasks are waiting.
+ */
+static BaseType_t prvFastSemaphoreGiveContended( FastSemaphore_t * const pxSemaphore ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	FastSemaphoreHandle_t xFastSemaphoreCreateStatic( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticFastSemaphore_t *pxFastSemaphoreBuffer )
+	{
+	FastSemaphore_t *pxSemaphore;
+
+		configASSERT( pxFastSemaphoreBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticFastSemaphore_t equals the size of the real
+			semaphore structure. */
+			volatile size_t xSize = sizeof( StaticFastSemaphore_t );
+			configASSERT( xSize == sizeof( FastSemaphore_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxSemaphore = ( FastSemaphore_t * ) pxFastSemaphoreBuffer; /*lint !e740 !e9087 FastSemaphore_t and StaticFastSemaphore_t are deliberately aliased for data hiding purposes. */
+
+		if( pxSemaphore != NULL )
+		{
+			prvInitialiseFastSemaphore( pxSemaphore, uxMaxCount, uxInitialCount );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxSemaphore->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceFAST_SEMAPHORE_CREATE( pxSemaphore );
+		}
+		else
+		{
+			traceFAST_SEMAPHORE_CREATE_FAILED();
+		}
+
+		return pxSemaphore;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	FastSemaphoreHandle_t xFastSemaphoreCreate( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount )
+	{
+	FastSemaphore_t *pxSemaphore;
+
+		pxSemaphore = ( FastSemaphore_t * ) pvPortMalloc( sizeof( FastSemaphore_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxSemaphore != NULL )
+		{
+			prvInitialiseFastSemaphore( pxSemaphore, uxMaxCount, uxInitialCount );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxSemaphore->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceFAST_SEMAPHORE_CREATE( pxSemaphore );
+		}
+		else
+		{
+			traceFAST_SEMAPHORE_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxSemaphore;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseFastSemaphore( FastSemaphore_t * const pxSemaphore, UBaseType_t uxMaxCount, UBaseType_t uxInitialCount )
+{
+	configASSERT( uxMaxCount != 0U );
+	configASSERT( uxMaxCount < ( UBaseType_t ) fastsemaphoreWAITERS_BIT );
+	configASSERT( uxInitialCount <= uxMaxCount );
+
+	pxSemaphore->ulCount = ( uint32_t ) uxInitialCount;
+	pxSemaphore->ulMaxCount = ( uint32_t ) uxMaxCount;
+	vListInitialise( &( pxSemaphore->xTasksWaiting ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastSemaphoreTake( FastSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait )
+{
+FastSemaphore_t * const pxSemaphore = xSemaphore;
+uint32_t ulCount;
+BaseType_t xReturn;
+
+	configASSERT( pxSemaphore );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		ulCount = pxSemaphore->ulCount;
+
+		if( ( ulCount == 0U ) || ( ( ulCount & fastsemaphoreWAITERS_BIT ) != 0U ) )
+		{
+			xReturn = prvFastSemaphoreTakeContended( pxSemaphore, xTicksToWait );
+			break;
+		}
+		else if( Atomic_CompareAndSwap_u32( &( pxSemaphore->ulCount ), ulCount - 1U, ulCount ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+		{
+			traceFAST_SEMAPHORE_TAKE( pxSemaphore );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			/* Another task changed the count between the read and the
+			compare-and-swap. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFastSemaphoreGive( FastSemaphoreHandle_t xSemaphore )
+{
+FastSemaphore_t * const pxSemaphore = xSemaphore;
+uint32_t ulCount;
+BaseType_t xReturn;
+
+	configASSERT( pxSemaphore );
+
+	for( ;; )
+	{
+		ulCount = pxSemaphore->ulCount;
+
+		if( ( ulCount & fastsemaphoreWAITERS_BIT ) != 0U )
+		{
+			xReturn = prvFastSemaphoreGiveContended( pxSemaphore );
+			break;
+		}
+		else if( ulCount >= pxSemaphore->ulMaxCount )
+		{
+			traceFAST_SEMAPHORE_GIVE_FAILED( pxSemaphore );
+			xReturn = pdFAIL;
+			break;
+		}
+		else if( Atomic_CompareAndSwap_u32( &( pxSemaphore->ulCount ), ulCount + 1U, ulCount ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+		{
+			traceFAST_SEMAPHORE_GIVE( pxSemaphore );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxFastSemaphoreGetCount( FastSemaphoreHandle_t xSemaphore )
+{
+FastSemaphore_t * const pxSemaphore = xSemaphore;
+
+	configASSERT( pxSemaphore );
+
+	return ( UBaseType_t ) fastsemaphoreCOUNT( pxSemaphore->ulCount );
+}
+/*-----------------------------------------------------------*/
+
+void vFastSemaphoreDelete( FastSemaphoreHandle_t xSemaphore )
+{
+FastSemaphore_t * const pxSemaphore = xSemaphore;
+
+	configASSERT( pxSemaphore );
+	configASSERT( listLIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) != pdFALSE );
+
+	traceFAST_SEMAPHORE_DELETE( pxSemaphore );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxSemaphore );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxSemaphore->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxSemaphore );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFastSemaphoreTakeContended( FastSemaphore_t * const pxSemaphore, TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+uint32_t ulCount;
+
+	for( ;; )
+	{
+		/* Fast semaphores are not used from interrupts, so with the scheduler
+		suspended no other task can change ulCount. */
+		vTaskSuspendAll();
+
+		ulCount = fastsemaphoreCOUNT( pxSemaphore->ulCount );
+
+		if( ulCount != 0U )
+		{
+			ulCount--;
+
+			if( listLIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) == pdFALSE )
+			{
+				ulCount |= fastsemaphoreWAITERS_BIT;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxSemaphore->ulCount = ulCount;
+			( void ) xTaskResumeAll();
+
+			traceFAST_SEMAPHORE_TAKE( pxSemaphore );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			traceBLOCKING_ON_FAST_SEMAPHORE_TAKE( pxSemaphore );
+
+			/* Make the next give go through the kernel. */
+			pxSemaphore->ulCount = fastsemaphoreWAITERS_BIT;
+
+			vTaskPlaceOnEventList( &( pxSemaphore->xTasksWaiting ), xTicksToWait );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* Timed out.  This task has already been removed from the list of
+			waiting tasks, and the count is zero. */
+			if( listLIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) != pdFALSE )
+			{
+				pxSemaphore->ulCount = 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) xTaskResumeAll();
+
+			traceFAST_SEMAPHORE_TAKE_FAILED( pxSemaphore );
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFastSemaphoreGiveContended( FastSemaphore_t * const pxSemaphore )
+{
+BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+uint32_t ulCount;
+
+	taskENTER_CRITICAL();
+	{
+		ulCount = fastsemaphoreCOUNT( pxSemaphore->ulCount );
+
+		if( ulCount < pxSemaphore->ulMaxCount )
+		{
+			/* Wake the highest priority waiter, it takes the count when it
+			runs.  The count stays off the fast paths while tasks still
+			wait. */
+			if( listLIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxSemaphore->xTasksWaiting ) ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			ulCount++;
+
+			if( listLIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) == pdFALSE )
+			{
+				ulCount |= fastsemaphoreWAITERS_BIT;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxSemaphore->ulCount = ulCount;
+			traceFAST_SEMAPHORE_GIVE( pxSemaphore );
+		}
+		else
+		{
+			traceFAST_SEMAPHORE_GIVE_FAILED( pxSemaphore );
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		fastsemaphoreYIELD_IF_USING_PREEMPTION();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
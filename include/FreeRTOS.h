@@ -214,6 +214,22 @@ extern "C" {
 	#define configUSE_MUTEXES 0
 #endif
 
+#ifndef configUSE_MUTEX_CEILING
+	#define configUSE_MUTEX_CEILING 0
+#endif
+
+#ifndef configUSE_TRANSITIVE_INHERITANCE
+	#define configUSE_TRANSITIVE_INHERITANCE 0
+#endif
+
+#ifndef configUSE_FAST_LOCKS
+	#define configUSE_FAST_LOCKS 0
+#endif
+
+#ifndef configUSE_RW_LOCKS
+	#define configUSE_RW_LOCKS 0
+#endif
+
 #ifndef configUSE_TIMERS
 	#define configUSE_TIMERS 0
 #endif
@@ -704,6 +720,334 @@ extern "C" {
 	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceFAST_LOCK_CREATE
+	#define traceFAST_LOCK_CREATE( xLock )
+#endif
+
+#ifndef traceFAST_LOCK_CREATE_FAILED
+	#define traceFAST_LOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceFAST_LOCK_TAKE
+	#define traceFAST_LOCK_TAKE( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_FAST_LOCK_TAKE
+	#define traceBLOCKING_ON_FAST_LOCK_TAKE( xLock )
+#endif
+
+#ifndef traceFAST_LOCK_TAKE_FAILED
+	#define traceFAST_LOCK_TAKE_FAILED( xLock )
+#endif
+
+#ifndef traceFAST_LOCK_GIVE
+	#define traceFAST_LOCK_GIVE( xLock )
+#endif
+
+#ifndef traceFAST_LOCK_DELETE
+	#define traceFAST_LOCK_DELETE( xLock )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_CREATE
+	#define traceFAST_SEMAPHORE_CREATE( xSemaphore )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_CREATE_FAILED
+	#define traceFAST_SEMAPHORE_CREATE_FAILED()
+#endif
+
+#ifndef traceFAST_SEMAPHORE_TAKE
+	#define traceFAST_SEMAPHORE_TAKE( xSemaphore )
+#endif
+
+#ifndef traceBLOCKING_ON_FAST_SEMAPHORE_TAKE
+	#define traceBLOCKING_ON_FAST_SEMAPHORE_TAKE( xSemaphore )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_TAKE_FAILED
+	#define traceFAST_SEMAPHORE_TAKE_FAILED( xSemaphore )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_GIVE
+	#define traceFAST_SEMAPHORE_GIVE( xSemaphore )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_GIVE_FAILED
+	#define traceFAST_SEMAPHORE_GIVE_FAILED( xSemaphore )
+#endif
+
+#ifndef traceFAST_SEMAPHORE_DELETE
+	#define traceFAST_SEMAPHORE_DELETE( xSemaphore )
+#endif
+
+#ifndef traceRW_LOCK_CREATE
+	#define traceRW_LOCK_CREATE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_CREATE_FAILED
+	#define traceRW_LOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceRW_LOCK_READ_TAKE
+	#define traceRW_LOCK_READ_TAKE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_WRITE_TAKE
+	#define traceRW_LOCK_WRITE_TAKE( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RW_LOCK_TAKE
+	#define traceBLOCKING_ON_RW_LOCK_TAKE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_FAILED
+	#define traceRW_LOCK_TAKE_FAILED( xLock )
+#endif
+
+#ifndef traceRW_LOCK_READ_GIVE
+	#define traceRW_LOCK_READ_GIVE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_WRITE_GIVE
+	#define traceRW_LOCK_WRITE_GIVE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_DELETE
+	#define traceRW_LOCK_DELETE( xLock )
+#endif
+
+#ifndef tracePOLL_SET_CREATE
+	#define tracePOLL_SET_CREATE( xPollSet )
+#endif
+
+#ifndef tracePOLL_SET_CREATE_FAILED
+	#define tracePOLL_SET_CREATE_FAILED()
+#endif
+
+#ifndef tracePOLL_SET_ADD
+	#define tracePOLL_SET_ADD( xPollSet, pvObject )
+#endif
+
+#ifndef tracePOLL_SET_REMOVE
+	#define tracePOLL_SET_REMOVE( xPollSet, pvObject )
+#endif
+
+#ifndef traceBLOCKING_ON_POLL_SET_WAIT
+	#define traceBLOCKING_ON_POLL_SET_WAIT( xPollSet )
+#endif
+
+#ifndef tracePOLL_SET_WAIT
+	#define tracePOLL_SET_WAIT( xPollSet, uxCount )
+#endif
+
+#ifndef tracePOLL_SET_DELETE
+	#define tracePOLL_SET_DELETE( xPollSet )
+#endif
+
+#ifndef traceMPSC_QUEUE_CREATE
+	#define traceMPSC_QUEUE_CREATE( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_CREATE_FAILED
+	#define traceMPSC_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceMPSC_QUEUE_SEND
+	#define traceMPSC_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_SEND_FAILED
+	#define traceMPSC_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_SEND_FROM_ISR
+	#define traceMPSC_QUEUE_SEND_FROM_ISR( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_SEND_FROM_ISR_FAILED
+	#define traceMPSC_QUEUE_SEND_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_RECEIVE
+	#define traceMPSC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_MPSC_QUEUE_RECEIVE
+	#define traceBLOCKING_ON_MPSC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_RECEIVE_FAILED
+	#define traceMPSC_QUEUE_RECEIVE_FAILED( xQueue )
+#endif
+
+#ifndef traceMPSC_QUEUE_DELETE
+	#define traceMPSC_QUEUE_DELETE( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_CREATE
+	#define tracePRIORITY_QUEUE_CREATE( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_CREATE_FAILED
+	#define tracePRIORITY_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND
+	#define tracePRIORITY_QUEUE_SEND( xQueue, uxPriority )
+#endif
+
+#ifndef traceBLOCKING_ON_PRIORITY_QUEUE_SEND
+	#define traceBLOCKING_ON_PRIORITY_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FAILED
+	#define tracePRIORITY_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FROM_ISR
+	#define tracePRIORITY_QUEUE_SEND_FROM_ISR( xQueue, uxPriority )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED
+	#define tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE
+	#define tracePRIORITY_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE
+	#define traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FAILED
+	#define tracePRIORITY_QUEUE_RECEIVE_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FROM_ISR
+	#define tracePRIORITY_QUEUE_RECEIVE_FROM_ISR( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED
+	#define tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_DELETE
+	#define tracePRIORITY_QUEUE_DELETE( xQueue )
+#endif
+
+#ifndef traceREF_BUFFER_POOL_CREATE
+	#define traceREF_BUFFER_POOL_CREATE( xPool )
+#endif
+
+#ifndef traceREF_BUFFER_POOL_CREATE_FAILED
+	#define traceREF_BUFFER_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceREF_BUFFER_ALLOC
+	#define traceREF_BUFFER_ALLOC( xBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_REF_BUFFER_ALLOC
+	#define traceBLOCKING_ON_REF_BUFFER_ALLOC( xPool )
+#endif
+
+#ifndef traceREF_BUFFER_ALLOC_FAILED
+	#define traceREF_BUFFER_ALLOC_FAILED( xPool )
+#endif
+
+#ifndef traceREF_BUFFER_FREE
+	#define traceREF_BUFFER_FREE( xBuffer )
+#endif
+
+#ifndef traceREF_BUFFER_POOL_DELETE
+	#define traceREF_BUFFER_POOL_DELETE( xPool )
+#endif
+
+#ifndef traceTOPIC_CREATE
+	#define traceTOPIC_CREATE( xTopic )
+#endif
+
+#ifndef traceTOPIC_CREATE_FAILED
+	#define traceTOPIC_CREATE_FAILED()
+#endif
+
+#ifndef traceTOPIC_SUBSCRIBE
+	#define traceTOPIC_SUBSCRIBE( xTopic, xSubscriber )
+#endif
+
+#ifndef traceTOPIC_UNSUBSCRIBE
+	#define traceTOPIC_UNSUBSCRIBE( xTopic, xSubscriber )
+#endif
+
+#ifndef traceTOPIC_PUBLISH
+	#define traceTOPIC_PUBLISH( xTopic )
+#endif
+
+#ifndef traceTOPIC_PUBLISH_FROM_ISR
+	#define traceTOPIC_PUBLISH_FROM_ISR( xTopic )
+#endif
+
+#ifndef traceBLOCKING_ON_TOPIC_PUBLISH
+	#define traceBLOCKING_ON_TOPIC_PUBLISH( xTopic )
+#endif
+
+#ifndef traceTOPIC_PUBLISH_FAILED
+	#define traceTOPIC_PUBLISH_FAILED( xTopic )
+#endif
+
+#ifndef traceTOPIC_PUBLISH_FROM_ISR_FAILED
+	#define traceTOPIC_PUBLISH_FROM_ISR_FAILED( xTopic )
+#endif
+
+#ifndef traceTOPIC_RECEIVE
+	#define traceTOPIC_RECEIVE( xTopic, xSubscriber )
+#endif
+
+#ifndef traceBLOCKING_ON_TOPIC_RECEIVE
+	#define traceBLOCKING_ON_TOPIC_RECEIVE( xTopic, xSubscriber )
+#endif
+
+#ifndef traceTOPIC_RECEIVE_FAILED
+	#define traceTOPIC_RECEIVE_FAILED( xTopic, xSubscriber )
+#endif
+
+#ifndef traceTOPIC_DELETE
+	#define traceTOPIC_DELETE( xTopic )
+#endif
+
+#ifndef traceCOND_VAR_CREATE
+	#define traceCOND_VAR_CREATE( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_CREATE_FAILED
+	#define traceCOND_VAR_CREATE_FAILED()
+#endif
+
+#ifndef traceBLOCKING_ON_COND_VAR_WAIT
+	#define traceBLOCKING_ON_COND_VAR_WAIT( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_WAIT
+	#define traceCOND_VAR_WAIT( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_WAIT_FAILED
+	#define traceCOND_VAR_WAIT_FAILED( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_SIGNAL
+	#define traceCOND_VAR_SIGNAL( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_BROADCAST
+	#define traceCOND_VAR_BROADCAST( xCondVar )
+#endif
+
+#ifndef traceCOND_VAR_DELETE
+	#define traceCOND_VAR_DELETE( xCondVar )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -770,6 +1114,12 @@ extern "C" {
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_QUEUE_HANDOFF
+	/* Send an item straight into the buffer of a task blocked in
+	xQueueReceive(), rather than through the queue storage area. */
+	#define configUSE_QUEUE_HANDOFF 0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
@@ -818,6 +1168,14 @@ extern "C" {
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #endif
 
+#ifndef configUSE_PRIORITY_BITMAP_TASK_SELECTION
+	#define configUSE_PRIORITY_BITMAP_TASK_SELECTION 0
+#endif
+
+#if ( ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) )
+	#error configUSE_PRIORITY_BITMAP_TASK_SELECTION and configUSE_PORT_OPTIMISED_TASK_SELECTION cannot both be set to 1.
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
@@ -826,6 +1184,14 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1.
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
@@ -872,6 +1238,22 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if( ( configUSE_TRANSITIVE_INHERITANCE == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#if( ( configUSE_FAST_LOCKS == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( configUSE_TRANSITIVE_INHERITANCE == 1 ) ) )
+	#error Fast locks need configUSE_MUTEXES set to 1 and cannot be used with configUSE_TRANSITIVE_INHERITANCE
+#endif
+
+#if( ( configUSE_RW_LOCKS == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( configUSE_TRANSITIVE_INHERITANCE == 1 ) ) )
+	#error Reader-writer locks need configUSE_MUTEXES set to 1 and cannot be used with configUSE_TRANSITIVE_INHERITANCE
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -998,6 +1380,128 @@ the Secure Side only. */
 	#define configUSE_TASK_START_HOOK 0
 #endif
 
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		#define configEDF_PRIORITY ( configMAX_PRIORITIES - 1 )
+	#endif
+
+	#if ( configEDF_PRIORITY >= configMAX_PRIORITIES ) || ( configEDF_PRIORITY == 0 )
+		#error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES.
+	#endif
+
+	#if ( configUSE_TIMERS == 1 ) && ( configEDF_PRIORITY == configTIMER_TASK_PRIORITY )
+		#error configEDF_PRIORITY must not be the timer task priority, define configEDF_PRIORITY in FreeRTOSConfig.h.
+	#endif
+#endif
+
+#ifndef configUSE_TASK_BUDGET
+	#define configUSE_TASK_BUDGET 0
+#endif
+
+#ifndef configTASK_BUDGET_BACKGROUND_PRIORITY
+	/* The priority a task is demoted to when its CPU budget is exhausted. */
+	#define configTASK_BUDGET_BACKGROUND_PRIORITY 0
+#endif
+
+#ifndef configUSE_PREEMPTION_THRESHOLD
+	#define configUSE_PREEMPTION_THRESHOLD 0
+#endif
+
+#ifndef configUSE_TASK_TIME_SLICE
+	#define configUSE_TASK_TIME_SLICE 0
+#endif
+
+#ifndef configDEFAULT_TIME_SLICE
+	/* The round robin quantum of a new task in ticks. */
+	#define configDEFAULT_TIME_SLICE 1
+#endif
+
+#ifndef configUSE_PARTITIONS
+	#define configUSE_PARTITIONS 0
+#endif
+
+#if ( configUSE_PARTITIONS == 1 )
+	#ifndef configNUM_PARTITIONS
+		/* Partition 0 is the system partition, it is never switched out. */
+		#define configNUM_PARTITIONS 4
+	#endif
+
+	#ifndef configPARTITION_BACKGROUND
+		/* The partition that gets the idle time of the other windows, 0 for
+		none. */
+		#define configPARTITION_BACKGROUND 0
+	#endif
+
+	#if ( configNUM_PARTITIONS < 2 ) || ( configPARTITION_BACKGROUND >= configNUM_PARTITIONS )
+		#error configNUM_PARTITIONS must be at least 2 and configPARTITION_BACKGROUND below it.
+	#endif
+#endif
+
+#ifndef configEVENT_GROUP_ISR_MAX_WAITERS
+	/* xEventGroupSetBitsFromISR() unblocks waiting tasks itself when no more
+	than this many tasks wait on the event group, 0 always defers to the timer
+	task. */
+	#define configEVENT_GROUP_ISR_MAX_WAITERS 0
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_BUCKET_BITS
+	/* Tasks waiting on an event group are indexed by buckets of this many
+	bits, each with its own list, so setting bits only tests the tasks that wait
+	for them.  0 keeps a single list. */
+	#define configEVENT_GROUP_WAITER_BUCKET_BITS 0
+#endif
+
+#if ( configEVENT_GROUP_WAITER_BUCKET_BITS != 0 ) && ( configEVENT_GROUP_WAITER_BUCKET_BITS != 1 ) && ( configEVENT_GROUP_WAITER_BUCKET_BITS != 2 ) && ( configEVENT_GROUP_WAITER_BUCKET_BITS != 4 ) && ( configEVENT_GROUP_WAITER_BUCKET_BITS != 8 )
+	#error configEVENT_GROUP_WAITER_BUCKET_BITS must be 0, 1, 2, 4 or 8.
+#endif
+
+#ifndef configUSE_POLL_SETS
+	#define configUSE_POLL_SETS 0
+#endif
+
+#ifndef configPOLL_SET_MAX_MEMBERS
+	/* The ready members of a poll set are kept in a 32 bit bitmap. */
+	#define configPOLL_SET_MAX_MEMBERS 16
+#endif
+
+#if ( configPOLL_SET_MAX_MEMBERS < 1 ) || ( configPOLL_SET_MAX_MEMBERS > 32 )
+	#error configPOLL_SET_MAX_MEMBERS must be between 1 and 32.
+#endif
+
+#ifndef configUSE_MPSC_QUEUES
+	#define configUSE_MPSC_QUEUES 0
+#endif
+
+#ifndef configMPSC_QUEUE_NOTIFY_INDEX
+	/* The task notification a task receiving from a multi-producer single
+	consumer queue blocks on. */
+	#define configMPSC_QUEUE_NOTIFY_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if configMPSC_QUEUE_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#error configMPSC_QUEUE_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+#endif
+
+#if ( configUSE_MPSC_QUEUES == 1 ) && ( configMPSC_QUEUE_NOTIFY_INDEX == 0 )
+	/* The receiver takes the notification with xClearCountOnExit set, which
+	would clear notifications sent with xTaskNotify() and xTaskNotifyGive(). */
+	#error configMPSC_QUEUE_NOTIFY_INDEX must not be tskDEFAULT_INDEX_TO_NOTIFY, set configTASK_NOTIFICATION_ARRAY_ENTRIES to 2 or more.
+#endif
+
+#ifndef configPRIORITY_QUEUE_LEVELS
+	/* The number of item priorities of a priority queue, which keeps the
+	priorities that have items in a 32 bit bitmap. */
+	#define configPRIORITY_QUEUE_LEVELS 8
+#endif
+
+#if ( configPRIORITY_QUEUE_LEVELS < 1 ) || ( configPRIORITY_QUEUE_LEVELS > 32 )
+	#error configPRIORITY_QUEUE_LEVELS must be between 1 and 32.
+#endif
+
 #ifndef portGetDspHeartBeat
 	#define portGetDspHeartBeat() 0
 #endif
@@ -1144,8 +1648,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
@@ -1160,6 +1664,38 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_TASK_START_HOOK == 1 )
 		void			*pxDummy23[2];
 	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy25[ 4 ];
+	#endif
+	#if ( configUSE_TASK_BUDGET == 1 )
+		void			*pxDummy26[ 2 ];
+		UBaseType_t		uxDummy26;
+		uint8_t			ucDummy26;
+	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxDummy27;
+		void			*pxDummy27;
+		uint8_t			ucDummy27;
+	#endif
+	#if ( configUSE_TASK_TIME_SLICE == 1 )
+		TickType_t		xDummy28[ 2 ];
+	#endif
+	#if ( configUSE_PARTITIONS == 1 )
+		UBaseType_t		uxDummy29;
+	#endif
+	#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+		StaticList_t	xDummy30;
+		void			*pvDummy30;
+	#endif
+	#if ( configUSE_POLL_SETS == 1 )
+		void			*pvDummy31;
+	#endif
+	#if ( configUSE_QUEUE_HANDOFF == 1 )
+		void			*pvDummy32;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		uint8_t			ucDummy33;
+	#endif
 	#if ENABLE_KASAN
 		int		iDummy24;
 	#endif
@@ -1206,6 +1742,18 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t uxDummy10;
+	#endif
+
+	#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+		StaticListItem_t xDummy11;
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvDummy12;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1226,7 +1774,22 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+
+	#if( configEVENT_GROUP_WAITER_BUCKET_BITS > 0 )
+		/* One list per bucket of the usable bits, plus one. */
+		StaticList_t xDummy2[ ( ( ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ) / configEVENT_GROUP_WAITER_BUCKET_BITS ) + 1 ];
+	#else
+		StaticList_t xDummy2;
+	#endif
+
+	#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+		UBaseType_t uxDummy5;
+		TickType_t xDummy6;
+	#endif
+
+	#if( configUSE_POLL_SETS == 1 )
+		void *pvDummy7;
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
@@ -1288,11 +1851,193 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_POLL_SETS == 1 )
+		void * pvDummy5;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the fast lock structure is not accessible to
+ * application code.  The StaticFastLock_t structure below has the size and
+ * alignment of the genuine structure, for use with xFastLockCreateStatic().
+ */
+typedef struct xSTATIC_FAST_LOCK
+{
+	void *pvDummy1;
+	StaticList_t xDummy2;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy3;
+	#endif
+} StaticFastLock_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the fast semaphore structure is not accessible to
+ * application code.  The StaticFastSemaphore_t structure below has the size and
+ * alignment of the genuine structure, for use with xFastSemaphoreCreateStatic().
+ */
+typedef struct xSTATIC_FAST_SEMAPHORE
+{
+	uint32_t ulDummy1[ 2 ];
+	StaticList_t xDummy2;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy3;
+	#endif
+} StaticFastSemaphore_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the reader-writer lock structure is not accessible to
+ * application code.  The StaticRWLock_t structure below has the size and
+ * alignment of the genuine structure, for use with xRWLockCreateStatic().
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+	void *pvDummy1;
+	StaticList_t xDummy2[ 2 ];
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy3;
+	#endif
+} StaticRWLock_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the poll set structure is not accessible to
+ * application code.  The StaticPollSet_t structure below has the size and
+ * alignment of the genuine structure, for use with xPollSetCreateStatic().
+ */
+typedef struct xSTATIC_POLL_SET
+{
+	uint32_t ulDummy1[ 2 ];
+	StaticList_t xDummy2;
+	UBaseType_t uxDummy3;
+	struct
+	{
+		void *pvDummy4[ 3 ];
+		TickType_t xDummy5;
+		uint8_t ucDummy6[ 2 ];
+	} xDummy7[ configPOLL_SET_MAX_MEMBERS ];
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy8;
+	#endif
+} StaticPollSet_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the multi-producer single-consumer queue structure is
+ * not accessible to application code.  The StaticMPSCQueue_t structure below
+ * has the size and alignment of the genuine structure, for use with
+ * xMPSCQueueCreateStatic().
+ */
+typedef struct xSTATIC_MPSC_QUEUE
+{
+	uint32_t ulDummy1[ 3 ];
+	size_t xDummy2;
+	UBaseType_t uxDummy3;
+	void *pvDummy4[ 2 ];
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+} StaticMPSCQueue_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the priority queue structure is not accessible to
+ * application code.  The StaticPriorityQueue_t structure below has the size
+ * and alignment of the genuine structure, for use with
+ * xPriorityQueueCreateStatic().
+ */
+typedef struct xSTATIC_PRIORITY_QUEUE
+{
+	void *pvDummy1;
+	size_t xDummy2;
+	UBaseType_t uxDummy3[ 5 ];
+	UBaseType_t uxDummy4[ 2 ][ configPRIORITY_QUEUE_LEVELS ];
+	StaticList_t xDummy5[ 2 ];
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy6;
+	#endif
+} StaticPriorityQueue_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the reference counted buffer and buffer pool
+ * structures are not accessible to application code.  The StaticRefBuffer_t
+ * structure below has the size and alignment of the header of a buffer, for
+ * use by refbufferPOOL_STORAGE_SIZE(), and the StaticRefBufferPool_t structure
+ * has the size and alignment of a pool, for use with
+ * xRefBufferPoolCreateStatic().
+ */
+typedef struct xSTATIC_REF_BUFFER
+{
+	void *pvDummy1[ 2 ];
+	uint32_t ulDummy2;
+	size_t xDummy3;
+} StaticRefBuffer_t;
+
+typedef struct xSTATIC_REF_BUFFER_POOL
+{
+	void *pvDummy1[ 2 ];
+	UBaseType_t uxDummy2[ 2 ];
+	size_t xDummy3;
+	StaticList_t xDummy4;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+} StaticRefBufferPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the topic and topic subscriber structures are not
+ * accessible to application code.  The StaticTopic_t and
+ * StaticTopicSubscriber_t structures below have the size and alignment of the
+ * real structures, for use with xTopicCreateStatic() and
+ * xTopicSubscribeStatic().
+ */
+typedef struct xSTATIC_TOPIC
+{
+	void *pvDummy1;
+	UBaseType_t uxDummy2[ 4 ];
+	uint32_t ulDummy3;
+	StaticList_t xDummy4[ 3 ];
+	uint32_t ulDummy5;
+	UBaseType_t uxDummy6;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy7;
+	#endif
+} StaticTopic_t;
+
+typedef struct xSTATIC_TOPIC_SUBSCRIBER
+{
+	void *pvDummy1;
+	StaticListItem_t xDummy2;
+	uint32_t ulDummy3[ 2 ];
+	uint8_t ucDummy4;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy5;
+	#endif
+} StaticTopicSubscriber_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real condition variable structure is not
+ * accessible to application code.  The StaticCondVar_t structure below has
+ * the size and alignment of the real structure, for use with
+ * xCondVarCreateStatic().
+ */
+typedef struct xSTATIC_COND_VAR
+{
+	void *pvDummy1;
+	StaticList_t xDummy2;
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy3;
+	#endif
+} StaticCondVar_t;
+
 #ifdef __cplusplus
 }
 #endif
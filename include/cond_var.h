@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef COND_VAR_H
+#define COND_VAR_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include cond_var.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A condition variable lets tasks that hold a mutex wait for a condition on
+ * the data the mutex protects, and lets the task that changes the data wake
+ * them.  Each condition variable is bound to one mutex, created with
+ * xSemaphoreCreateMutex() or xSemaphoreCreateMutexStatic(), when it is
+ * created.
+ *
+ * A waiting task gives the mutex and blocks in one step, so a signal sent
+ * after the mutex is given cannot be missed, and holds the mutex again when
+ * xCondVarWait() returns.  Signalling does not make the woken tasks ready:
+ * they are moved straight onto the list of tasks waiting for the mutex, and
+ * each runs only once it is its turn to hold the mutex.  A broadcast to many
+ * tasks therefore costs one context switch per task as the mutex is passed
+ * on, instead of every task waking only to block again on the mutex.  The
+ * holder of the mutex inherits the priority of the moved tasks, as if they had
+ * called xSemaphoreTake() themselves.
+ *
+ * As with any condition variable, a task must test its condition again after
+ * xCondVarWait() returns, whatever the return value, as another task may have
+ * held the mutex first and changed the data.
+ *
+ * Condition variables cannot be used from an interrupt, or with recursive
+ * mutexes.  configUSE_MUTEXES must be set to 1.
+ *
+ * \defgroup CondVar
+ */
+
+/**
+ * cond_var.h
+ *
+ * Type by which condition variables are referenced.
+ *
+ * \defgroup CondVarHandle_t CondVarHandle_t
+ * \ingroup CondVar
+ */
+struct CondVarDef_t;
+typedef struct CondVarDef_t * CondVarHandle_t;
+
+/**
+ * cond_var.h
+ *<pre>
+ CondVarHandle_t xCondVarCreate( SemaphoreHandle_t xMutex );
+ </pre>
+ *
+ * Create a new condition variable, allocating it with pvPortMalloc().
+ *
+ * @param xMutex The mutex that protects the data the condition is about.
+ *
+ * @return A handle to the condition variable, or NULL if there was not enough
+ * heap.
+ *
+ * \defgroup xCondVarCreate xCondVarCreate
+ * \ingroup CondVar
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	CondVarHandle_t xCondVarCreate( SemaphoreHandle_t xMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * cond_var.h
+ *<pre>
+ CondVarHandle_t xCondVarCreateStatic( SemaphoreHandle_t xMutex, StaticCondVar_t *pxCondVarBuffer );
+ </pre>
+ *
+ * Create a new condition variable in memory provided by the application
+ * writer.
+ *
+ * @param xMutex The mutex that protects the data the condition is about.
+ *
+ * @param pxCondVarBuffer Must point to a variable of type StaticCondVar_t,
+ * which will be used to hold the condition variable structure.
+ *
+ * @return A handle to the condition variable, or NULL if pxCondVarBuffer was
+ * NULL.
+ *
+ * \defgroup xCondVarCreateStatic xCondVarCreateStatic
+ * \ingroup CondVar
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	CondVarHandle_t xCondVarCreateStatic( SemaphoreHandle_t xMutex, StaticCondVar_t *pxCondVarBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * cond_var.h
+ *<pre>
+ BaseType_t xCondVarWait( CondVarHandle_t xCondVar, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Give the mutex of a condition variable, which the calling task must hold,
+ * wait for the condition variable to be signalled, then take the mutex again.
+ *
+ * @param xCondVar The condition variable to wait on.
+ *
+ * @param xTicksToWait The maximum time to wait for a signal.  Once signalled
+ * the task waits for the mutex for as long as it takes.  If xTicksToWait is 0
+ * the function returns at once, without giving the mutex.
+ *
+ * @return pdTRUE if the task was signalled before xTicksToWait expired,
+ * pdFALSE if it expired first.  In both cases the task holds the mutex on
+ * return.
+ *
+ * Example usage:
+ <pre>
+ SemaphoreHandle_t xLock;
+ CondVarHandle_t xNotEmpty;
+ UBaseType_t uxCount;
+
+ void vConsumer( void *pvParameters )
+ {
+    xSemaphoreTake( xLock, portMAX_DELAY );
+    {
+        while( uxCount == 0 )
+        {
+            xCondVarWait( xNotEmpty, portMAX_DELAY );
+        }
+
+        uxCount--;
+    }
+    xSemaphoreGive( xLock );
+ }
+
+ void vProducer( void *pvParameters )
+ {
+    xSemaphoreTake( xLock, portMAX_DELAY );
+    {
+        uxCount++;
+        vCondVarSignal( xNotEmpty );
+    }
+    xSemaphoreGive( xLock );
+ }
+ </pre>
+ * \defgroup xCondVarWait xCondVarWait
+ * \ingroup CondVar
+ */
+BaseType_t xCondVarWait( CondVarHandle_t xCondVar, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * cond_var.h
+ *<pre>
+ void vCondVarSignal( CondVarHandle_t xCondVar );
+ </pre>
+ *
+ * Wake the highest priority task waiting on a condition variable, if any.
+ * The task is moved to the list of tasks waiting for the mutex, so it runs
+ * once the mutex is given.  The calling task would normally hold the mutex.
+ *
+ * \defgroup vCondVarSignal vCondVarSignal
+ * \ingroup CondVar
+ */
+void vCondVarSignal( CondVarHandle_t xCondVar ) PRIVILEGED_FUNCTION;
+
+/**
+ * cond_var.h
+ *<pre>
+ void vCondVarBroadcast( CondVarHandle_t xCondVar );
+ </pre>
+ *
+ * Wake every task waiting on a condition variable.  The tasks are moved to
+ * the list of tasks waiting for the mutex, and run one at a time, in priority
+ * order, as the mutex is passed from one to the next.
+ *
+ * \defgroup vCondVarBroadcast vCondVarBroadcast
+ * \ingroup CondVar
+ */
+void vCondVarBroadcast( CondVarHandle_t xCondVar ) PRIVILEGED_FUNCTION;
+
+/**
+ * cond_var.h
+ *<pre>
+ void vCondVarDelete( CondVarHandle_t xCondVar );
+ </pre>
+ *
+ * Delete a condition variable.  No task can be waiting on it.  The mutex is
+ * not deleted.
+ *
+ * \defgroup vCondVarDelete vCondVarDelete
+ * \ingroup CondVar
+ */
+void vCondVarDelete( CondVarHandle_t xCondVar ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COND_VAR_H */
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef FAST_LOCK_H
+#define FAST_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include fast_lock.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A fast lock is a mutual exclusion lock for short critical regions, such as
+ * a read-modify-write of a group of device registers.  When the lock is free
+ * xFastLockTake() is a single compare-and-swap, and when no task is waiting
+ * xFastLockGive() is a single compare-and-swap, neither enters the kernel.
+ * Only a task that finds the lock held enters the kernel, where it blocks and
+ * the holder inherits its priority as with a mutex created by
+ * xSemaphoreCreateMutex().
+ *
+ * The compare-and-swap comes from atomic.h.  With configUSE_GCC_BUILTIN_ATOMICS
+ * set to 1 it uses the exclusive load/store instructions of the core and the
+ * fast paths do not enter a critical section.  Otherwise atomic.h masks
+ * interrupts around the compare-and-swap, which is still much shorter than the
+ * critical sections of xSemaphoreTake() and xSemaphoreGive().
+ *
+ * A fast lock is not recursive and cannot be used from an interrupt.  Fast
+ * locks are not recorded in the list of mutexes a task holds, so they cannot be
+ * used with configUSE_TRANSITIVE_INHERITANCE.  configUSE_FAST_LOCKS must be set
+ * to 1 in FreeRTOSConfig.h for fast locks to be available.  See
+ * fast_semaphore.h for a counting semaphore with the same fast paths.
+ *
+ * \defgroup FastLock
+ */
+
+/**
+ * fast_lock.h
+ *
+ * Type by which fast locks are referenced.
+ *
+ * \defgroup FastLockHandle_t FastLockHandle_t
+ * \ingroup FastLock
+ */
+struct FastLockDef_t;
+typedef struct FastLockDef_t * FastLockHandle_t;
+
+/**
+ * fast_lock.h
+ *<pre>
+ FastLockHandle_t xFastLockCreate( void );
+ </pre>
+ *
+ * Create a new fast lock.  The lock structure is allocated with
+ * pvPortMalloc(), use xFastLockCreateStatic() to provide the memory instead.
+ * The lock is a few words in size, much smaller than a mutex.
+ *
+ * @return A handle to the lock, or NULL if there was not enough heap.
+ *
+ * \defgroup xFastLockCreate xFastLockCreate
+ * \ingroup FastLock
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	FastLockHandle_t xFastLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_lock.h
+ *<pre>
+ FastLockHandle_t xFastLockCreateStatic( StaticFastLock_t *pxFastLockBuffer );
+ </pre>
+ *
+ * Create a new fast lock in memory provided by the application writer.
+ *
+ * @param pxFastLockBuffer Must point to a variable of type StaticFastLock_t,
+ * which will be used to hold the lock structure.
+ *
+ * @return A handle to the lock, or NULL if pxFastLockBuffer was NULL.
+ *
+ * Example usage:
+ <pre>
+ StaticFastLock_t xRegLockBuffer;
+ FastLockHandle_t xRegLock;
+
+ void vDriverInit( void )
+ {
+    xRegLock = xFastLockCreateStatic( &xRegLockBuffer );
+ }
+
+ void vDriverSetBits( uint32_t ulBits )
+ {
+    xFastLockTake( xRegLock, portMAX_DELAY );
+    REG_CTRL |= ulBits;
+    xFastLockGive( xRegLock );
+ }
+ </pre>
+ * \defgroup xFastLockCreateStatic xFastLockCreateStatic
+ * \ingroup FastLock
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	FastLockHandle_t xFastLockCreateStatic( StaticFastLock_t *pxFastLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_lock.h
+ *<pre>
+ BaseType_t xFastLockTake( FastLockHandle_t xLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take a fast lock, waiting up to xTicksToWait ticks for it to be given if it
+ * is held by another task.  Must not be called by the task that already holds
+ * the lock.
+ *
+ * @param xLock The lock to take.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.  0 returns
+ * at once, portMAX_DELAY waits without a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if xTicksToWait expired first.
+ *
+ * \defgroup xFastLockTake xFastLockTake
+ * \ingroup FastLock
+ */
+BaseType_t xFastLockTake( FastLockHandle_t xLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_lock.h
+ *<pre>
+ BaseType_t xFastLockGive( FastLockHandle_t xLock );
+ </pre>
+ *
+ * Give a fast lock back.  Only the task that holds the lock can give it.  If
+ * tasks are waiting the highest priority one is unblocked, and a priority the
+ * caller inherited while it held the lock is given back.
+ *
+ * @param xLock The lock to give.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xFastLockGive xFastLockGive
+ * \ingroup FastLock
+ */
+BaseType_t xFastLockGive( FastLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_lock.h
+ *<pre>
+ void vFastLockDelete( FastLockHandle_t xLock );
+ </pre>
+ *
+ * Delete a fast lock.  The lock must not be held and no task can be waiting
+ * for it.
+ *
+ * @param xLock The lock to delete.
+ *
+ * \defgroup vFastLockDelete vFastLockDelete
+ * \ingroup FastLock
+ */
+void vFastLockDelete( FastLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FAST_LOCK_H */
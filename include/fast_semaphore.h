@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef FAST_SEMAPHORE_H
+#define FAST_SEMAPHORE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include fast_semaphore.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A fast semaphore is a counting semaphore whose count is a single word.
+ * While no task is waiting, xFastSemaphoreTake() with a count available and
+ * xFastSemaphoreGive() are each a single compare-and-swap of the count and do
+ * not enter the kernel.  Only a task that finds the count at zero enters the
+ * kernel to block, and the next give then wakes it through the kernel.
+ *
+ * As with fast locks (see fast_lock.h) the compare-and-swap comes from
+ * atomic.h, and only avoids masking interrupts if configUSE_GCC_BUILTIN_ATOMICS
+ * is set to 1.
+ *
+ * Unlike a semaphore created by xSemaphoreCreateCounting(), a fast semaphore
+ * cannot be given or taken from an interrupt, and a task that is woken takes
+ * the count when it runs, so a task that takes the count first keeps it.
+ *
+ * \defgroup FastSemaphore
+ */
+
+/**
+ * fast_semaphore.h
+ *
+ * Type by which fast semaphores are referenced.
+ *
+ * \defgroup FastSemaphoreHandle_t FastSemaphoreHandle_t
+ * \ingroup FastSemaphore
+ */
+struct FastSemaphoreDef_t;
+typedef struct FastSemaphoreDef_t * FastSemaphoreHandle_t;
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ FastSemaphoreHandle_t xFastSemaphoreCreate( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount );
+ </pre>
+ *
+ * Create a new fast semaphore, allocating it with pvPortMalloc().
+ *
+ * @param uxMaxCount The highest count the semaphore can reach, less than
+ * 0x80000000.  1 creates a binary semaphore.
+ *
+ * @param uxInitialCount The count the semaphore starts with.
+ *
+ * @return A handle to the semaphore, or NULL if there was not enough heap.
+ *
+ * \defgroup xFastSemaphoreCreate xFastSemaphoreCreate
+ * \ingroup FastSemaphore
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	FastSemaphoreHandle_t xFastSemaphoreCreate( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ FastSemaphoreHandle_t xFastSemaphoreCreateStatic( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticFastSemaphore_t *pxFastSemaphoreBuffer );
+ </pre>
+ *
+ * Create a new fast semaphore in memory provided by the application writer.
+ *
+ * @param uxMaxCount The highest count the semaphore can reach, less than
+ * 0x80000000.  1 creates a binary semaphore.
+ *
+ * @param uxInitialCount The count the semaphore starts with.
+ *
+ * @param pxFastSemaphoreBuffer Must point to a variable of type
+ * StaticFastSemaphore_t, which will be used to hold the semaphore structure.
+ *
+ * @return A handle to the semaphore, or NULL if pxFastSemaphoreBuffer was
+ * NULL.
+ *
+ * Example usage:
+ <pre>
+ StaticFastSemaphore_t xSlotsBuffer;
+ FastSemaphoreHandle_t xSlots;
+
+ void vDriverInit( void )
+ {
+    xSlots = xFastSemaphoreCreateStatic( 4, 4, &xSlotsBuffer );
+ }
+
+ void vDriverSubmit( void )
+ {
+    xFastSemaphoreTake( xSlots, portMAX_DELAY );
+    // Use one of the four hardware slots, and give it back once the hardware
+    // is done with it.
+ }
+
+ void vDriverComplete( void )
+ {
+    xFastSemaphoreGive( xSlots );
+ }
+ </pre>
+ * \defgroup xFastSemaphoreCreateStatic xFastSemaphoreCreateStatic
+ * \ingroup FastSemaphore
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	FastSemaphoreHandle_t xFastSemaphoreCreateStatic( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticFastSemaphore_t *pxFastSemaphoreBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ BaseType_t xFastSemaphoreTake( FastSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take one from the count of a fast semaphore, waiting up to xTicksToWait
+ * ticks for the count to be above zero.
+ *
+ * @param xSemaphore The semaphore to take.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.  0 returns
+ * at once, portMAX_DELAY waits without a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return pdPASS if the semaphore was taken, pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xFastSemaphoreTake xFastSemaphoreTake
+ * \ingroup FastSemaphore
+ */
+BaseType_t xFastSemaphoreTake( FastSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ BaseType_t xFastSemaphoreGive( FastSemaphoreHandle_t xSemaphore );
+ </pre>
+ *
+ * Add one to the count of a fast semaphore.  If tasks are waiting the highest
+ * priority one is unblocked.
+ *
+ * @param xSemaphore The semaphore to give.
+ *
+ * @return pdPASS, or pdFAIL if the count was already at its maximum.
+ *
+ * \defgroup xFastSemaphoreGive xFastSemaphoreGive
+ * \ingroup FastSemaphore
+ */
+BaseType_t xFastSemaphoreGive( FastSemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ UBaseType_t uxFastSemaphoreGetCount( FastSemaphoreHandle_t xSemaphore );
+ </pre>
+ *
+ * @param xSemaphore The semaphore to query.
+ *
+ * @return The current count of the semaphore.
+ *
+ * \defgroup uxFastSemaphoreGetCount uxFastSemaphoreGetCount
+ * \ingroup FastSemaphore
+ */
+UBaseType_t uxFastSemaphoreGetCount( FastSemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_semaphore.h
+ *<pre>
+ void vFastSemaphoreDelete( FastSemaphoreHandle_t xSemaphore );
+ </pre>
+ *
+ * Delete a fast semaphore.  No task can be waiting for it.
+ *
+ * @param xSemaphore The semaphore to delete.
+ *
+ * \defgroup vFastSemaphoreDelete vFastSemaphoreDelete
+ * \ingroup FastSemaphore
+ */
+void vFastSemaphoreDelete( FastSemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FAST_SEMAPHORE_H */
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include mpsc_queue.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A multi-producer single-consumer queue passes fixed size items from any
+ * number of tasks and interrupts to one receiving task.  Sending reserves a
+ * slot with a compare-and-swap on the write position and publishes the item
+ * with a sequence number kept in the slot, so a sender never enters a kernel
+ * critical section.  Only a send that finds the receiving task blocked enters
+ * the kernel, to unblock it with a task notification.
+ *
+ * The compare-and-swap comes from atomic.h.  With configUSE_GCC_BUILTIN_ATOMICS
+ * set to 1 it uses the exclusive load/store instructions of the core, so a
+ * sender never masks interrupts and senders at different interrupt priorities
+ * do not hold each other up.  Otherwise atomic.h masks interrupts for the few
+ * instructions of each compare-and-swap.
+ *
+ * Sending never blocks: a send to a full queue fails at once.  Only one task
+ * may receive from a queue.  It blocks on the notification at index
+ * configMPSC_QUEUE_NOTIFY_INDEX, which must not be used for anything else by
+ * that task, and so cannot be tskDEFAULT_INDEX_TO_NOTIFY.
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES must therefore be at least 2.  The
+ * queue length must be a power of 2.
+ *
+ * configUSE_MPSC_QUEUES must be set to 1, as must configUSE_TASK_NOTIFICATIONS,
+ * and configUSE_MUTEXES or INCLUDE_xTaskGetCurrentTaskHandle.
+ *
+ * \defgroup MPSCQueue
+ */
+
+/**
+ * mpsc_queue.h
+ *
+ * Type by which multi-producer single-consumer queues are referenced.
+ *
+ * \defgroup MPSCQueueHandle_t MPSCQueueHandle_t
+ * \ingroup MPSCQueue
+ */
+struct MPSCQueueDef_t;
+typedef struct MPSCQueueDef_t * MPSCQueueHandle_t;
+
+/**
+ * mpsc_queue.h
+ *
+ * The number of bytes of storage a queue of uxLength items of uxItemSize bytes
+ * needs, for the buffer passed to xMPSCQueueCreateStatic().  Each item is
+ * stored with a 32 bit sequence number.
+ */
+#define mpscqueueSTORAGE_SIZE( uxLength, uxItemSize )	( ( size_t ) ( uxLength ) * ( ( sizeof( uint32_t ) + ( size_t ) ( uxItemSize ) + sizeof( uint32_t ) - 1U ) & ~( sizeof( uint32_t ) - 1U ) ) )
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ MPSCQueueHandle_t xMPSCQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ </pre>
+ *
+ * Create a new multi-producer single-consumer queue, allocating it with
+ * pvPortMalloc().
+ *
+ * @param uxLength The maximum number of items the queue can hold, a power of
+ * 2.
+ *
+ * @param uxItemSize The size in bytes of each item, which must not be 0.
+ *
+ * @return A handle to the queue, or NULL if there was not enough heap.
+ *
+ * \defgroup xMPSCQueueCreate xMPSCQueueCreate
+ * \ingroup MPSCQueue
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MPSCQueueHandle_t xMPSCQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ MPSCQueueHandle_t xMPSCQueueCreateStatic( UBaseType_t uxLength,
+                                           UBaseType_t uxItemSize,
+                                           uint8_t *pucQueueStorageBuffer,
+                                           StaticMPSCQueue_t *pxMPSCQueueBuffer );
+ </pre>
+ *
+ * Create a new multi-producer single-consumer queue in memory provided by the
+ * application writer.
+ *
+ * @param uxLength The maximum number of items the queue can hold, a power of
+ * 2.
+ *
+ * @param uxItemSize The size in bytes of each item, which must not be 0.
+ *
+ * @param pucQueueStorageBuffer A 32 bit aligned buffer of at least
+ * mpscqueueSTORAGE_SIZE( uxLength, uxItemSize ) bytes.
+ *
+ * @param pxMPSCQueueBuffer Must point to a variable of type StaticMPSCQueue_t,
+ * which will be used to hold the queue structure.
+ *
+ * @return A handle to the queue, or NULL if pxMPSCQueueBuffer was NULL.
+ *
+ * \defgroup xMPSCQueueCreateStatic xMPSCQueueCreateStatic
+ * \ingroup MPSCQueue
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	MPSCQueueHandle_t xMPSCQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorageBuffer, StaticMPSCQueue_t *pxMPSCQueueBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ BaseType_t xMPSCQueueSend( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue );
+ </pre>
+ *
+ * Copy an item to the back of the queue.  Can be called by any number of tasks
+ * at the same time.
+ *
+ * @param xQueue The queue to send to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @return pdPASS if the item was sent, errQUEUE_FULL if the queue was full.
+ *
+ * Example usage:
+ <pre>
+ MPSCQueueHandle_t xSampleQueue;
+
+ void vSensorTask( void *pvParameters )
+ {
+ Sample_t xSample;
+
+    for( ;; )
+    {
+        vReadSensor( &xSample );
+
+        if( xMPSCQueueSend( xSampleQueue, &xSample ) != pdPASS )
+        {
+            ulDropped++;
+        }
+    }
+ }
+
+ void vAdcInterruptHandler( void )
+ {
+ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ Sample_t xSample;
+
+    vReadAdc( &xSample );
+    ( void ) xMPSCQueueSendFromISR( xSampleQueue, &xSample, &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ }
+
+ void vLoggerTask( void *pvParameters )
+ {
+ Sample_t xSample;
+
+    for( ;; )
+    {
+        if( xMPSCQueueReceive( xSampleQueue, &xSample, portMAX_DELAY ) == pdPASS )
+        {
+            vLogSample( &xSample );
+        }
+    }
+ }
+ </pre>
+ * \defgroup xMPSCQueueSend xMPSCQueueSend
+ * \ingroup MPSCQueue
+ */
+BaseType_t xMPSCQueueSend( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ BaseType_t xMPSCQueueSendFromISR( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xMPSCQueueSend() that can be called from an interrupt service
+ * routine, at any interrupt priority up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * @param xQueue The queue to send to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * the receiving task and it has a priority above the interrupted task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdPASS if the item was sent, errQUEUE_FULL if the queue was full.
+ *
+ * \defgroup xMPSCQueueSendFromISR xMPSCQueueSendFromISR
+ * \ingroup MPSCQueue
+ */
+BaseType_t xMPSCQueueSendFromISR( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ BaseType_t xMPSCQueueReceive( MPSCQueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Copy the item at the front of the queue into pvBuffer and remove it, waiting
+ * up to xTicksToWait ticks for one to be sent.  Items are received in the
+ * order their senders reserved their slots.  An item whose sender has
+ * reserved its slot but not finished copying it holds back the items behind
+ * it until the copy is complete.
+ *
+ * @param xQueue The queue to receive from.
+ *
+ * @param pvBuffer A buffer of the item size of the queue.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if an item was received, errQUEUE_EMPTY if xTicksToWait
+ * expired first.
+ *
+ * \defgroup xMPSCQueueReceive xMPSCQueueReceive
+ * \ingroup MPSCQueue
+ */
+BaseType_t xMPSCQueueReceive( MPSCQueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ UBaseType_t uxMPSCQueueMessagesWaiting( MPSCQueueHandle_t xQueue );
+ </pre>
+ *
+ * @param xQueue The queue to query.
+ *
+ * @return The number of slots reserved by senders and not yet received.  This
+ * includes items that are still being copied in.
+ *
+ * \defgroup uxMPSCQueueMessagesWaiting uxMPSCQueueMessagesWaiting
+ * \ingroup MPSCQueue
+ */
+UBaseType_t uxMPSCQueueMessagesWaiting( MPSCQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpsc_queue.h
+ *<pre>
+ void vMPSCQueueDelete( MPSCQueueHandle_t xQueue );
+ </pre>
+ *
+ * Delete a multi-producer single-consumer queue.  No task can be waiting to
+ * receive from it and no sender can be using it.
+ *
+ * @param xQueue The queue to delete.
+ *
+ * \defgroup vMPSCQueueDelete vMPSCQueueDelete
+ * \ingroup MPSCQueue
+ */
+void vMPSCQueueDelete( MPSCQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSC_QUEUE_H */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef POLL_SET_H
+#define POLL_SET_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include poll_set.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A poll set lets one task wait for any of a number of kernel objects to
+ * become ready, like epoll().  Unlike a queue set nothing is copied into the
+ * poll set when a member becomes ready: the member only sets its bit in the
+ * ready bitmap of the set, so the set needs no storage for the items of its
+ * members.  Queues, semaphores, mutexes, stream buffers, message buffers,
+ * event groups and task notifications can all be members.
+ *
+ * uxPollSetWait() blocks until at least one member is ready, then returns the
+ * handles of the ready members in one call.  A level triggered member is
+ * reported for as long as its object is ready, an edge triggered member is
+ * reported once each time its object is written to.
+ *
+ * An object can be a member of one poll set at a time and must be removed
+ * from the set before it is deleted.  A poll set holds up to
+ * configPOLL_SET_MAX_MEMBERS members.  configUSE_POLL_SETS must be set to 1.
+ *
+ * \defgroup PollSet
+ */
+
+/**
+ * poll_set.h
+ *
+ * Type by which poll sets are referenced.
+ *
+ * \defgroup PollSetHandle_t PollSetHandle_t
+ * \ingroup PollSet
+ */
+struct PollSetDef_t;
+typedef struct PollSetDef_t * PollSetHandle_t;
+
+/* The record of one member within a poll set.  Only used by the kernel. */
+struct PollMemberDef_t;
+typedef struct PollMemberDef_t * PollMemberHandle_t;
+
+/**
+ * The kind of object a poll set member is, and when it is ready.
+ */
+typedef enum
+{
+	ePollQueue = 0,			/* A queue, semaphore or mutex, ready while it holds an item. */
+	ePollStreamBuffer,		/* A stream or message buffer, ready while it holds data. */
+	ePollEventGroup,		/* An event group, ready while one of the bits of interest is set. */
+	ePollTaskNotification	/* A task, ready while it has a notification pending at tskDEFAULT_INDEX_TO_NOTIFY. */
+} ePollObjectType;
+
+/* Values for the xTrigger parameter of xPollSetAdd(). */
+#define pollLEVEL_TRIGGERED		( ( BaseType_t ) 0 )
+#define pollEDGE_TRIGGERED		( ( BaseType_t ) 1 )
+
+/**
+ * A ready member, as returned by uxPollSetWait().
+ */
+typedef struct xPOLL_EVENT
+{
+	void *pvObject;				/*< The handle of the object. */
+	void *pvUserData;			/*< The value passed to xPollSetAdd() with the object. */
+	ePollObjectType eType;		/*< The kind of object. */
+} PollEvent_t;
+
+/**
+ * poll_set.h
+ *<pre>
+ PollSetHandle_t xPollSetCreate( void );
+ </pre>
+ *
+ * Create a new poll set, allocating it with pvPortMalloc().
+ *
+ * @return A handle to the poll set, or NULL if there was not enough heap.
+ *
+ * \defgroup xPollSetCreate xPollSetCreate
+ * \ingroup PollSet
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	PollSetHandle_t xPollSetCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * poll_set.h
+ *<pre>
+ PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t *pxPollSetBuffer );
+ </pre>
+ *
+ * Create a new poll set in memory provided by the application writer.
+ *
+ * @param pxPollSetBuffer Must point to a variable of type StaticPollSet_t,
+ * which will be used to hold the poll set structure.
+ *
+ * @return A handle to the poll set, or NULL if pxPollSetBuffer was NULL.
+ *
+ * \defgroup xPollSetCreateStatic xPollSetCreateStatic
+ * \ingroup PollSet
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t *pxPollSetBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * poll_set.h
+ *<pre>
+ BaseType_t xPollSetAdd( PollSetHandle_t xPollSet,
+                         ePollObjectType eType,
+                         void *pvObject,
+                         EventBits_t uxEvents,
+                         BaseType_t xTrigger,
+                         void *pvUserData );
+ </pre>
+ *
+ * Add an object to a poll set.  If the object is ready already it is reported
+ * by the next call to uxPollSetWait().
+ *
+ * @param xPollSet The poll set to add the object to.
+ *
+ * @param eType The kind of object pvObject is.
+ *
+ * @param pvObject The handle of the object: a QueueHandle_t,
+ * SemaphoreHandle_t, StreamBufferHandle_t, MessageBufferHandle_t,
+ * EventGroupHandle_t or TaskHandle_t as given by eType.
+ *
+ * @param uxEvents For an event group, the bits of interest.  Ignored for other
+ * objects.
+ *
+ * @param xTrigger pollLEVEL_TRIGGERED or pollEDGE_TRIGGERED.
+ *
+ * @param pvUserData Returned with the object by uxPollSetWait().
+ *
+ * @return pdPASS if the object was added, pdFAIL if the poll set is full or the
+ * object is already a member of a poll set.
+ *
+ * \defgroup xPollSetAdd xPollSetAdd
+ * \ingroup PollSet
+ */
+BaseType_t xPollSetAdd( PollSetHandle_t xPollSet, ePollObjectType eType, void *pvObject, EventBits_t uxEvents, BaseType_t xTrigger, void *pvUserData ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ *<pre>
+ BaseType_t xPollSetRemove( PollSetHandle_t xPollSet, void *pvObject );
+ </pre>
+ *
+ * Remove an object from a poll set.
+ *
+ * @param xPollSet The poll set to remove the object from.
+ *
+ * @param pvObject The handle passed to xPollSetAdd().
+ *
+ * @return pdPASS if the object was removed, pdFAIL if it was not a member.
+ *
+ * \defgroup xPollSetRemove xPollSetRemove
+ * \ingroup PollSet
+ */
+BaseType_t xPollSetRemove( PollSetHandle_t xPollSet, void *pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ *<pre>
+ UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollEvent_t * const pxEvents, const UBaseType_t uxMaxEvents, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Wait up to xTicksToWait ticks for members of a poll set to become ready.
+ * Reading from the ready objects is left to the caller.  If more than
+ * uxMaxEvents members are ready the others are reported by the next call, so
+ * no member is starved.
+ *
+ * @param xPollSet The poll set to wait on.
+ *
+ * @param pxEvents An array of uxMaxEvents entries the ready members are
+ * written to.
+ *
+ * @param uxMaxEvents The number of entries in pxEvents.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return The number of entries written to pxEvents, 0 if xTicksToWait expired
+ * before a member was ready.
+ *
+ * Example usage:
+ <pre>
+ void vGatewayTask( void *pvParameters )
+ {
+ PollSetHandle_t xPollSet = xPollSetCreate();
+ PollEvent_t xEvents[ 8 ];
+ UBaseType_t uxEvent, uxCount;
+
+    xPollSetAdd( xPollSet, ePollQueue, xUartQueue, 0, pollLEVEL_TRIGGERED, vHandleUart );
+    xPollSetAdd( xPollSet, ePollStreamBuffer, xSpiStream, 0, pollLEVEL_TRIGGERED, vHandleSpi );
+    xPollSetAdd( xPollSet, ePollEventGroup, xLinkEvents, LINK_UP | LINK_DOWN, pollEDGE_TRIGGERED, vHandleLink );
+
+    for( ;; )
+    {
+        uxCount = uxPollSetWait( xPollSet, xEvents, 8, portMAX_DELAY );
+
+        for( uxEvent = 0; uxEvent < uxCount; uxEvent++ )
+        {
+            ( ( void ( * )( void * ) ) xEvents[ uxEvent ].pvUserData )( xEvents[ uxEvent ].pvObject );
+        }
+    }
+ }
+ </pre>
+ * \defgroup uxPollSetWait uxPollSetWait
+ * \ingroup PollSet
+ */
+UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollEvent_t * const pxEvents, const UBaseType_t uxMaxEvents, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ *<pre>
+ void vPollSetDelete( PollSetHandle_t xPollSet );
+ </pre>
+ *
+ * Delete a poll set.  The set must have no members and no task can be waiting
+ * on it.
+ *
+ * @param xPollSet The poll set to delete.
+ *
+ * \defgroup vPollSetDelete vPollSetDelete
+ * \ingroup PollSet
+ */
+void vPollSetDelete( PollSetHandle_t xPollSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FUNCTIONS BELOW MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE THE
+ * INTERFACE BETWEEN POLL SETS AND THE OBJECTS THAT CAN BE MEMBERS.
+ */
+
+/* The uxBits value objects other than event groups signal with. */
+#define pollOBJECT_WRITTEN		( ~( ( EventBits_t ) 0 ) )
+
+/*
+ * Called by a member object when uxBits become set, or with pollOBJECT_WRITTEN
+ * when it is written to.  Must be called with interrupts masked, either from a
+ * critical section or from an interrupt.  Returns pdTRUE if a task with a
+ * priority above the calling task was unblocked.
+ */
+BaseType_t xPollSetSignal( PollMemberHandle_t xMember, const EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record xMember in the object, or clear it if xMember is NULL.  Return pdFAIL
+ * if the object is a member of a poll set already.
+ */
+BaseType_t xQueueSetPollMember( QueueHandle_t xQueue, PollMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferSetPollMember( StreamBufferHandle_t xStreamBuffer, PollMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+BaseType_t xEventGroupSetPollMember( EventGroupHandle_t xEventGroup, PollMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskSetPollMember( TaskHandle_t xTask, PollMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return pdTRUE if xTask has a notification pending, for level triggered
+ * members.
+ */
+BaseType_t xTaskNotifyStatePending( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_SET_H */
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include priority_queue.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A priority queue is a queue in which each item is sent with a priority, from
+ * 0 up to configPRIORITY_QUEUE_LEVELS - 1.  A receive always returns the
+ * highest priority item in the queue, and items of equal priority are
+ * received in the order they were sent.  One priority queue can so replace a
+ * set of queues that a receiver would otherwise poll in priority order.
+ *
+ * Items of each priority are kept in their own list, and a bitmap records the
+ * priorities that have items, so sending and receiving take the same time
+ * whatever the number of items in the queue.  Tasks block and time out on a
+ * priority queue as they do on a queue, and items can be sent and received
+ * from interrupts.
+ *
+ * \defgroup PriorityQueue
+ */
+
+/**
+ * priority_queue.h
+ *
+ * Type by which priority queues are referenced.
+ *
+ * \defgroup PriorityQueueHandle_t PriorityQueueHandle_t
+ * \ingroup PriorityQueue
+ */
+struct PriorityQueueDef_t;
+typedef struct PriorityQueueDef_t * PriorityQueueHandle_t;
+
+/**
+ * priority_queue.h
+ *
+ * The number of bytes of storage a priority queue of uxLength items of
+ * uxItemSize bytes needs, for the buffer passed to
+ * xPriorityQueueCreateStatic().  Each item is stored with the index of the
+ * item behind it.
+ */
+#define priorityqueueSTORAGE_SIZE( uxLength, uxItemSize )	( ( size_t ) ( uxLength ) * ( ( sizeof( UBaseType_t ) + ( size_t ) ( uxItemSize ) + sizeof( UBaseType_t ) - 1U ) & ~( sizeof( UBaseType_t ) - 1U ) ) )
+
+/**
+ * priority_queue.h
+ *<pre>
+ PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ </pre>
+ *
+ * Create a new priority queue, allocating it with pvPortMalloc().
+ *
+ * @param uxLength The maximum number of items the queue can hold, of all
+ * priorities together.
+ *
+ * @param uxItemSize The size in bytes of each item, which must not be 0.
+ *
+ * @return A handle to the queue, or NULL if there was not enough heap.
+ *
+ * \defgroup xPriorityQueueCreate xPriorityQueueCreate
+ * \ingroup PriorityQueue
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * priority_queue.h
+ *<pre>
+ PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength,
+                                                   UBaseType_t uxItemSize,
+                                                   uint8_t *pucQueueStorageBuffer,
+                                                   StaticPriorityQueue_t *pxPriorityQueueBuffer );
+ </pre>
+ *
+ * Create a new priority queue in memory provided by the application writer.
+ *
+ * @param uxLength The maximum number of items the queue can hold, of all
+ * priorities together.
+ *
+ * @param uxItemSize The size in bytes of each item, which must not be 0.
+ *
+ * @param pucQueueStorageBuffer A buffer of at least
+ * priorityqueueSTORAGE_SIZE( uxLength, uxItemSize ) bytes, aligned for a
+ * UBaseType_t.
+ *
+ * @param pxPriorityQueueBuffer Must point to a variable of type
+ * StaticPriorityQueue_t, which will be used to hold the queue structure.
+ *
+ * @return A handle to the queue, or NULL if pxPriorityQueueBuffer was NULL.
+ *
+ * \defgroup xPriorityQueueCreateStatic xPriorityQueueCreateStatic
+ * \ingroup PriorityQueue
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorageBuffer, StaticPriorityQueue_t *pxPriorityQueueBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * priority_queue.h
+ *<pre>
+ BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Copy an item into the queue behind the items of the same priority, waiting
+ * up to xTicksToWait ticks for space.
+ *
+ * @param xQueue The queue to send to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param uxPriority The priority of the item, less than
+ * configPRIORITY_QUEUE_LEVELS.  Higher values are received first.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if the item was sent, errQUEUE_FULL if xTicksToWait expired
+ * first.
+ *
+ * Example usage:
+ <pre>
+ #define CMD_BULK	0
+ #define CMD_URGENT	1
+
+ PriorityQueueHandle_t xCommandQueue;
+
+ void vRequestAbort( void )
+ {
+ Command_t xCommand = { CMD_ABORT };
+
+    xPriorityQueueSend( xCommandQueue, &xCommand, CMD_URGENT, portMAX_DELAY );
+ }
+
+ void vDispatcherTask( void *pvParameters )
+ {
+ Command_t xCommand;
+
+    for( ;; )
+    {
+        if( xPriorityQueueReceive( xCommandQueue, &xCommand, NULL, portMAX_DELAY ) == pdPASS )
+        {
+            vDispatch( &xCommand );
+        }
+    }
+ }
+ </pre>
+ * \defgroup xPriorityQueueSend xPriorityQueueSend
+ * \ingroup PriorityQueue
+ */
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *<pre>
+ BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xPriorityQueueSend() that can be called from an interrupt
+ * service routine.  It does not wait for space.
+ *
+ * @param xQueue The queue to send to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param uxPriority The priority of the item, less than
+ * configPRIORITY_QUEUE_LEVELS.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a task with a priority above the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was sent, errQUEUE_FULL if the queue was full.
+ *
+ * \defgroup xPriorityQueueSendFromISR xPriorityQueueSendFromISR
+ * \ingroup PriorityQueue
+ */
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *<pre>
+ BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Copy the highest priority item, the oldest of that priority, into pvBuffer
+ * and remove it from the queue, waiting up to xTicksToWait ticks for an item
+ * to be sent.
+ *
+ * @param xQueue The queue to receive from.
+ *
+ * @param pvBuffer A buffer of the item size of the queue.
+ *
+ * @param puxPriority Set to the priority the item was sent with.  Can be NULL.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if an item was received, errQUEUE_EMPTY if xTicksToWait
+ * expired first.
+ *
+ * \defgroup xPriorityQueueReceive xPriorityQueueReceive
+ * \ingroup PriorityQueue
+ */
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *<pre>
+ BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xPriorityQueueReceive() that can be called from an interrupt
+ * service routine.  It does not wait for an item.
+ *
+ * @param xQueue The queue to receive from.
+ *
+ * @param pvBuffer A buffer of the item size of the queue.
+ *
+ * @param puxPriority Set to the priority the item was sent with.  Can be NULL.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if removing the item
+ * unblocked a task with a priority above the interrupted task, in which case
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if an item was received, errQUEUE_EMPTY if the queue was
+ * empty.
+ *
+ * \defgroup xPriorityQueueReceiveFromISR xPriorityQueueReceiveFromISR
+ * \ingroup PriorityQueue
+ */
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *<pre>
+ UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue );
+ </pre>
+ *
+ * @param xQueue The queue to query.
+ *
+ * @return The number of items in the queue, of all priorities together.
+ *
+ * \defgroup uxPriorityQueueMessagesWaiting uxPriorityQueueMessagesWaiting
+ * \ingroup PriorityQueue
+ */
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *<pre>
+ void vPriorityQueueDelete( PriorityQueueHandle_t xQueue );
+ </pre>
+ *
+ * Delete a priority queue.  No task can be waiting to send to or receive from
+ * it.
+ *
+ * @param xQueue The queue to delete.
+ *
+ * \defgroup vPriorityQueueDelete vPriorityQueueDelete
+ * \ingroup PriorityQueue
+ */
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIORITY_QUEUE_H */
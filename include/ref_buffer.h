@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef REF_BUFFER_H
+#define REF_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include ref_buffer.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A reference counted buffer carries a block of data, such as a frame, from
+ * task to task without copying it.  Queues and stream buffers carry only the
+ * handle of the buffer, and the buffer is freed when the last reference to it
+ * is released, so no task has to know which other tasks still use it.
+ *
+ * A buffer is taken from a pool of buffers of one size, or allocated with
+ * pvPortMalloc().  Allocation leaves the caller with one reference.  Sending
+ * the handle with one of the xRefBufferSendTo...() functions passes that
+ * reference to the receiving task, which releases it with vRefBufferRelease()
+ * when it is done with the buffer.  To pass the same buffer to several tasks,
+ * take a reference for each with vRefBufferRetain(), or send it with
+ * uxRefBufferSendToQueues().  The data of a buffer that more than one task
+ * holds a reference to must be treated as read only.
+ *
+ * References are counted with the atomic operations of atomic.h.  Buffers can
+ * be allocated from a pool and released from interrupts.  A buffer allocated
+ * with pvPortMalloc() that is released from an interrupt is freed by the timer
+ * task when configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall are set to 1.
+ * Otherwise, or if the timer command queue is full, it is freed by the next
+ * call to vRefBufferRelease() or xRefBufferAllocFromHeap() from a task.
+ *
+ * \defgroup RefBuffer
+ */
+
+/**
+ * ref_buffer.h
+ *
+ * Types by which reference counted buffers and pools of them are referenced.
+ *
+ * \defgroup RefBufferHandle_t RefBufferHandle_t
+ * \ingroup RefBuffer
+ */
+struct RefBufferDef_t;
+typedef struct RefBufferDef_t * RefBufferHandle_t;
+
+struct RefBufferPoolDef_t;
+typedef struct RefBufferPoolDef_t * RefBufferPoolHandle_t;
+
+/**
+ * ref_buffer.h
+ *
+ * The number of bytes of storage a pool of uxBuffers buffers of xBufferSize
+ * bytes needs, for the buffer passed to xRefBufferPoolCreateStatic().  The
+ * data of each buffer is aligned to portBYTE_ALIGNMENT.
+ */
+#define refbufferHEADER_SIZE							( ( sizeof( StaticRefBuffer_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define refbufferBLOCK_SIZE( xBufferSize )				( refbufferHEADER_SIZE + ( ( ( size_t ) ( xBufferSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) )
+#define refbufferPOOL_STORAGE_SIZE( uxBuffers, xBufferSize )	( ( size_t ) ( uxBuffers ) * refbufferBLOCK_SIZE( xBufferSize ) )
+
+/**
+ * ref_buffer.h
+ *<pre>
+ RefBufferPoolHandle_t xRefBufferPoolCreate( UBaseType_t uxBuffers, size_t xBufferSize );
+ </pre>
+ *
+ * Create a pool of uxBuffers buffers of xBufferSize bytes each, allocating it
+ * with pvPortMalloc().
+ *
+ * @return A handle to the pool, or NULL if there was not enough heap.
+ *
+ * \defgroup xRefBufferPoolCreate xRefBufferPoolCreate
+ * \ingroup RefBuffer
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RefBufferPoolHandle_t xRefBufferPoolCreate( UBaseType_t uxBuffers, size_t xBufferSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * ref_buffer.h
+ *<pre>
+ RefBufferPoolHandle_t xRefBufferPoolCreateStatic( UBaseType_t uxBuffers,
+                                                   size_t xBufferSize,
+                                                   uint8_t *pucPoolStorageBuffer,
+                                                   StaticRefBufferPool_t *pxPoolBuffer );
+ </pre>
+ *
+ * Create a pool of buffers in memory provided by the application writer.
+ *
+ * @param uxBuffers The number of buffers in the pool.
+ *
+ * @param xBufferSize The size in bytes of the data of each buffer.
+ *
+ * @param pucPoolStorageBuffer A buffer of at least
+ * refbufferPOOL_STORAGE_SIZE( uxBuffers, xBufferSize ) bytes, aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param pxPoolBuffer Must point to a variable of type StaticRefBufferPool_t,
+ * which will be used to hold the pool structure.
+ *
+ * @return A handle to the pool, or NULL if pxPoolBuffer was NULL.
+ *
+ * \defgroup xRefBufferPoolCreateStatic xRefBufferPoolCreateStatic
+ * \ingroup RefBuffer
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	RefBufferPoolHandle_t xRefBufferPoolCreateStatic( UBaseType_t uxBuffers, size_t xBufferSize, uint8_t *pucPoolStorageBuffer, StaticRefBufferPool_t *pxPoolBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * ref_buffer.h
+ *<pre>
+ RefBufferHandle_t xRefBufferAlloc( RefBufferPoolHandle_t xPool, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take a buffer from a pool, waiting up to xTicksToWait ticks for one to be
+ * released if all are in use.
+ *
+ * @param xPool The pool to take the buffer from.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return The buffer, holding one reference, or NULL if xTicksToWait expired
+ * first.
+ *
+ * Example usage:
+ <pre>
+ RefBufferPoolHandle_t xFramePool;
+ QueueHandle_t xEncoderQueue, xRecorderQueue;
+
+ void vCameraTask( void *pvParameters )
+ {
+ RefBufferHandle_t xFrame;
+ const QueueHandle_t xConsumers[ 2 ] = { xEncoderQueue, xRecorderQueue };
+
+    for( ;; )
+    {
+        xFrame = xRefBufferAlloc( xFramePool, portMAX_DELAY );
+        vCaptureFrame( pvRefBufferGetData( xFrame ), xRefBufferGetSize( xFrame ) );
+
+        // Both consumers get the same frame, then the reference taken by
+        // xRefBufferAlloc() is given up.
+        ( void ) uxRefBufferSendToQueues( xFrame, xConsumers, 2, portMAX_DELAY );
+        vRefBufferRelease( xFrame );
+    }
+ }
+
+ void vEncoderTask( void *pvParameters )
+ {
+ RefBufferHandle_t xFrame;
+
+    for( ;; )
+    {
+        if( xRefBufferReceiveFromQueue( xEncoderQueue, &xFrame, portMAX_DELAY ) == pdPASS )
+        {
+            vEncodeFrame( pvRefBufferGetData( xFrame ) );
+
+            // The frame goes back to the pool once the recorder has
+            // released it too.
+            vRefBufferRelease( xFrame );
+        }
+    }
+ }
+ </pre>
+ * \defgroup xRefBufferAlloc xRefBufferAlloc
+ * \ingroup RefBuffer
+ */
+RefBufferHandle_t xRefBufferAlloc( RefBufferPoolHandle_t xPool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ RefBufferHandle_t xRefBufferAllocFromISR( RefBufferPoolHandle_t xPool );
+ </pre>
+ *
+ * A version of xRefBufferAlloc() that can be called from an interrupt service
+ * routine.  It does not wait for a buffer.
+ *
+ * @return The buffer, holding one reference, or NULL if all the buffers of the
+ * pool are in use.
+ *
+ * \defgroup xRefBufferAllocFromISR xRefBufferAllocFromISR
+ * \ingroup RefBuffer
+ */
+RefBufferHandle_t xRefBufferAllocFromISR( RefBufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ RefBufferHandle_t xRefBufferAllocFromHeap( size_t xBufferSize );
+ </pre>
+ *
+ * Allocate a buffer of xBufferSize bytes with pvPortMalloc().  The buffer is
+ * freed with vPortFree() when the last reference to it is released.
+ *
+ * @return The buffer, holding one reference, or NULL if there was not enough
+ * heap.
+ *
+ * \defgroup xRefBufferAllocFromHeap xRefBufferAllocFromHeap
+ * \ingroup RefBuffer
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RefBufferHandle_t xRefBufferAllocFromHeap( size_t xBufferSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * ref_buffer.h
+ *<pre>
+ void *pvRefBufferGetData( RefBufferHandle_t xBuffer );
+ size_t xRefBufferGetSize( RefBufferHandle_t xBuffer );
+ </pre>
+ *
+ * Return the data of a buffer, aligned to portBYTE_ALIGNMENT, and its size in
+ * bytes.
+ *
+ * \defgroup pvRefBufferGetData pvRefBufferGetData
+ * \ingroup RefBuffer
+ */
+void *pvRefBufferGetData( RefBufferHandle_t xBuffer ) PRIVILEGED_FUNCTION;
+size_t xRefBufferGetSize( RefBufferHandle_t xBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ void vRefBufferRetain( RefBufferHandle_t xBuffer );
+ </pre>
+ *
+ * Add a reference to a buffer the caller holds a reference to.  Can be called
+ * from an interrupt.
+ *
+ * \defgroup vRefBufferRetain vRefBufferRetain
+ * \ingroup RefBuffer
+ */
+void vRefBufferRetain( RefBufferHandle_t xBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ void vRefBufferRelease( RefBufferHandle_t xBuffer );
+ </pre>
+ *
+ * Give up a reference to a buffer.  Releasing the last reference returns the
+ * buffer to its pool, unblocking a task waiting in xRefBufferAlloc(), or frees
+ * it if it was allocated with xRefBufferAllocFromHeap().
+ *
+ * \defgroup vRefBufferRelease vRefBufferRelease
+ * \ingroup RefBuffer
+ */
+void vRefBufferRelease( RefBufferHandle_t xBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ void vRefBufferReleaseFromISR( RefBufferHandle_t xBuffer, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of vRefBufferRelease() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if returning the buffer
+ * unblocked a task with a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vRefBufferReleaseFromISR vRefBufferReleaseFromISR
+ * \ingroup RefBuffer
+ */
+void vRefBufferReleaseFromISR( RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ BaseType_t xRefBufferSendToQueue( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, TickType_t xTicksToWait );
+ BaseType_t xRefBufferSendToQueueFromISR( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xRefBufferReceiveFromQueue( QueueHandle_t xQueue, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Send the handle of a buffer to the back of a queue created with an item size
+ * of sizeof( RefBufferHandle_t ), or receive one.  A send that succeeds passes
+ * the reference of the sender to the receiver.  A send that fails leaves it
+ * with the sender.
+ *
+ * @return pdPASS, or errQUEUE_FULL or errQUEUE_EMPTY as xQueueSend() and
+ * xQueueReceive() do.
+ *
+ * \defgroup xRefBufferSendToQueue xRefBufferSendToQueue
+ * \ingroup RefBuffer
+ */
+BaseType_t xRefBufferSendToQueue( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xRefBufferSendToQueueFromISR( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xRefBufferReceiveFromQueue( QueueHandle_t xQueue, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ UBaseType_t uxRefBufferSendToQueues( RefBufferHandle_t xBuffer, QueueHandle_t const * const pxQueues, UBaseType_t uxQueues, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Send a new reference to a buffer to each of uxQueues queues, so several
+ * tasks receive the same data without it being copied.  The caller keeps its
+ * own reference.
+ *
+ * @param xTicksToWait The maximum time to wait for space in each queue.
+ *
+ * @return The number of queues the buffer was sent to.
+ *
+ * \defgroup uxRefBufferSendToQueues uxRefBufferSendToQueues
+ * \ingroup RefBuffer
+ */
+UBaseType_t uxRefBufferSendToQueues( RefBufferHandle_t xBuffer, QueueHandle_t const * const pxQueues, UBaseType_t uxQueues, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ BaseType_t xRefBufferSendToStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, TickType_t xTicksToWait );
+ BaseType_t xRefBufferSendToStreamBufferFromISR( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xRefBufferReceiveFromStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait );
+ </pre>
+ *
+ * As xRefBufferSendToQueue() and xRefBufferReceiveFromQueue(), for a message
+ * buffer, or for a stream buffer that only carries buffer handles and holds a
+ * multiple of sizeof( RefBufferHandle_t ) bytes.  A stream buffer created with
+ * xStreamBufferCreate() holds xBufferSizeBytes bytes, but one created with
+ * xStreamBufferCreateStatic() holds xBufferSizeBytes - 1, so its storage area
+ * must be one byte longer than the multiple.  A handle is only sent if there
+ * is room for all of it.
+ *
+ * @return pdPASS, or errQUEUE_FULL or errQUEUE_EMPTY if the handle could not
+ * be sent or received before xTicksToWait expired.
+ *
+ * \defgroup xRefBufferSendToStreamBuffer xRefBufferSendToStreamBuffer
+ * \ingroup RefBuffer
+ */
+BaseType_t xRefBufferSendToStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xRefBufferSendToStreamBufferFromISR( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xRefBufferReceiveFromStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ UBaseType_t uxRefBufferPoolGetFree( RefBufferPoolHandle_t xPool );
+ </pre>
+ *
+ * @return The number of buffers of the pool not in use.
+ *
+ * \defgroup uxRefBufferPoolGetFree uxRefBufferPoolGetFree
+ * \ingroup RefBuffer
+ */
+UBaseType_t uxRefBufferPoolGetFree( RefBufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * ref_buffer.h
+ *<pre>
+ void vRefBufferPoolDelete( RefBufferPoolHandle_t xPool );
+ </pre>
+ *
+ * Delete a pool.  All its buffers must have been released and no task can be
+ * waiting for one.
+ *
+ * \defgroup vRefBufferPoolDelete vRefBufferPoolDelete
+ * \ingroup RefBuffer
+ */
+void vRefBufferPoolDelete( RefBufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REF_BUFFER_H */
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rw_lock.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A reader-writer lock protects data that is read far more often than it is
+ * written.  Any number of tasks can hold the lock for reading at the same
+ * time, a task that holds it for writing holds it alone.
+ *
+ * Writers are preferred: once a writer waits, tasks that ask for the lock for
+ * reading wait behind it, so a steady stream of readers cannot starve the
+ * writer.  The writer that holds the lock inherits the priority of the tasks
+ * waiting for it, as the holder of a mutex does.  Readers do not inherit.
+ *
+ * When the lock is given back and a writer waits, the lock is handed to that
+ * writer as it is unblocked, before it runs, so no other task can take the
+ * lock in between.  A task blocked in xRWLockWriteTake() must therefore not be
+ * deleted or suspended: once the lock has been handed to it, it stays held
+ * until that task runs and gives it back.
+ *
+ * Taking the lock for reading while no writer holds or waits for it, and
+ * giving a read lock back while no task waits, is a single compare-and-swap
+ * (see fast_lock.h for how atomic.h provides it).  The same applies to taking
+ * and giving a free lock for writing.  Waiting tasks block on the kernel event
+ * lists.
+ *
+ * A reader-writer lock is not recursive and cannot be used from an interrupt.
+ * As with fast locks, a lock held for writing is not recorded in the list of
+ * mutexes a task holds, so reader-writer locks cannot be used with
+ * configUSE_TRANSITIVE_INHERITANCE.  configUSE_RW_LOCKS must be set to 1 in
+ * FreeRTOSConfig.h for reader-writer locks to be available.
+ *
+ * \defgroup RWLock
+ */
+
+/**
+ * rw_lock.h
+ *
+ * Type by which reader-writer locks are referenced.
+ *
+ * \defgroup RWLockHandle_t RWLockHandle_t
+ * \ingroup RWLock
+ */
+struct RWLockDef_t;
+typedef struct RWLockDef_t * RWLockHandle_t;
+
+/**
+ * rw_lock.h
+ *<pre>
+ RWLockHandle_t xRWLockCreate( void );
+ </pre>
+ *
+ * Create a new reader-writer lock, allocating it with pvPortMalloc().
+ *
+ * @return A handle to the lock, or NULL if there was not enough heap.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLock
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *<pre>
+ RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer );
+ </pre>
+ *
+ * Create a new reader-writer lock in memory provided by the application
+ * writer.
+ *
+ * @param pxRWLockBuffer Must point to a variable of type StaticRWLock_t, which
+ * will be used to hold the lock structure.
+ *
+ * @return A handle to the lock, or NULL if pxRWLockBuffer was NULL.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLock
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *<pre>
+ BaseType_t xRWLockReadTake( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take the lock for reading, waiting up to xTicksToWait ticks while a writer
+ * holds or waits for it.
+ *
+ * @param xLock The lock to take.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if xTicksToWait expired first.
+ *
+ * Example usage:
+ <pre>
+ RWLockHandle_t xRouteLock;
+
+ uint32_t ulRouteLookup( uint32_t ulKey )
+ {
+ uint32_t ulValue;
+
+    xRWLockReadTake( xRouteLock, portMAX_DELAY );
+    ulValue = ulRouteTable[ ulKey ];
+    xRWLockReadGive( xRouteLock );
+
+    return ulValue;
+ }
+
+ void vRouteUpdate( uint32_t ulKey, uint32_t ulValue )
+ {
+    xRWLockWriteTake( xRouteLock, portMAX_DELAY );
+    ulRouteTable[ ulKey ] = ulValue;
+    xRWLockWriteGive( xRouteLock );
+ }
+ </pre>
+ * \defgroup xRWLockReadTake xRWLockReadTake
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockReadTake( RWLockHandle_t xLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *<pre>
+ BaseType_t xRWLockReadGive( RWLockHandle_t xLock );
+ </pre>
+ *
+ * Give back a lock taken with xRWLockReadTake().  The last reader to leave
+ * unblocks a waiting writer.
+ *
+ * @param xLock The lock to give.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xRWLockReadGive xRWLockReadGive
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockReadGive( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *<pre>
+ BaseType_t xRWLockWriteTake( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take the lock for writing, waiting up to xTicksToWait ticks for the readers
+ * and any writer to leave.  New readers wait from the moment the call blocks.
+ * The calling task must not be deleted or suspended while it waits, see the
+ * description of the hand over above.
+ *
+ * @param xLock The lock to take.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if xTicksToWait expired first.
+ *
+ * \defgroup xRWLockWriteTake xRWLockWriteTake
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockWriteTake( RWLockHandle_t xLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *<pre>
+ BaseType_t xRWLockWriteGive( RWLockHandle_t xLock );
+ </pre>
+ *
+ * Give back a lock taken with xRWLockWriteTake().  A waiting writer is
+ * unblocked first, otherwise all waiting readers are unblocked.
+ *
+ * @param xLock The lock to give.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xRWLockWriteGive xRWLockWriteGive
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockWriteGive( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *<pre>
+ void vRWLockDelete( RWLockHandle_t xLock );
+ </pre>
+ *
+ * Delete a reader-writer lock.  The lock must not be held and no task can be
+ * waiting for it.
+ *
+ * @param xLock The lock to delete.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLock
+ */
+void vRWLockDelete( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RW_LOCK_H */
@@ -777,6 +777,71 @@ typedef QueueHandle_t SemaphoreHandle_t;
 	#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority )</pre>
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead of
+ * waiting for contention to apply priority inheritance.  A task that takes
+ * the mutex runs at uxCeilingPriority, or at its own priority if that is
+ * higher, until it gives the mutex back.  No task that contends for the mutex
+ * can then preempt the holder, so the mutex never has a waiter and a task is
+ * blocked by at most one critical section of a lower priority task.
+ *
+ * uxCeilingPriority must be at least the priority of the highest priority task
+ * that takes the mutex.  A holder only returns to its base priority once it
+ * holds no mutexes, as with priority inheritance.
+ *
+ * configUSE_MUTEX_CEILING must be set to 1 in FreeRTOSConfig.h for this macro
+ * to be available.  The mutex is used with xSemaphoreTake() and
+ * xSemaphoreGive() like any other mutex, and cannot be used from interrupts.
+ *
+ * @param uxCeilingPriority The priority the holder runs at.  Passing
+ * tskIDLE_PRIORITY creates a mutex that uses priority inheritance only.
+ *
+ * @return A handle to the created mutex, or NULL if there was not enough heap
+ * to allocate the mutex data structures.
+ *
+ * Example usage:
+ <pre>
+ #define mainI2C_CEILING    ( tskIDLE_PRIORITY + 3 )
+
+ SemaphoreHandle_t xI2CMutex;
+
+ void vSetupI2C( void )
+ {
+    // Tasks of priority 1 to 3 use the bus.
+    xI2CMutex = xSemaphoreCreateMutexWithCeiling( mainI2C_CEILING );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority ) xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but the memory used by the mutex is
+ * provided by the application writer, see xSemaphoreCreateMutexStatic().
+ *
+ * @param uxCeilingPriority The priority the holder runs at.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return A handle to the created mutex, or NULL if pxMutexBuffer was NULL.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	#define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer ) xQueueCreateMutexWithCeilingStatic( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
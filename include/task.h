@@ -96,6 +96,25 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/*
+ * Type by which CPU budgets are referenced, see xTaskBudgetCreate().
+ */
+struct tskTaskBudget;
+typedef struct tskTaskBudget* TaskBudgetHandle_t;
+
+/* Actions taken when the CPU budget of a task is exhausted. */
+typedef enum
+{
+	eTaskBudgetDemote = 0,	/* Run the task at configTASK_BUDGET_BACKGROUND_PRIORITY until the budget is replenished. */
+	eTaskBudgetSuspend		/* Suspend the task until the budget is replenished. */
+} eTaskBudgetAction;
+
+/*
+ * Defines the prototype to which a budget overrun hook must conform.  The hook
+ * is called from the tick interrupt.
+ */
+typedef void (*TaskBudgetOverrunHook_t)( TaskHandle_t xTask, TaskBudgetHandle_t xBudget );
+
 /*
  * Used internally only.
  */
@@ -148,6 +167,13 @@ typedef struct xTASK_STATUS
 	StackType_t uStackTotal;
 } TaskStatus_t;
 
+/* One window of the partition schedule, see vTaskPartitionScheduleSet(). */
+typedef struct xPARTITION_WINDOW
+{
+	UBaseType_t uxPartition;	/* The partition that owns the window, 1 to configNUM_PARTITIONS - 1. */
+	TickType_t xDuration;		/* The length of the window in ticks. */
+} PartitionWindow_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -163,6 +189,15 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The notification index used by the task notification functions that do not
+ * take an index, such as xTaskNotify() and ulTaskNotifyTake().  Stream and
+ * message buffers use it too, so libraries should use the other indexes.
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( ( UBaseType_t ) 0U )
+
 /**
  * task. h
  *
@@ -336,6 +371,85 @@ is used in assert() statements. */
 							TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ *<pre>
+ BaseType_t xTaskCreateDeadline(
+							  TaskFunction_t pvTaskCode,
+							  const char * const pcName,
+							  configSTACK_DEPTH_TYPE usStackDepth,
+							  void *pvParameters,
+							  TickType_t xPeriod,
+							  TickType_t xRelativeDeadline,
+							  TickType_t xBudget,
+							  TaskHandle_t *pvCreatedTask
+						  );</pre>
+ *
+ * Create a periodic task in the earliest deadline first (EDF) band.
+ * configUSE_EDF_SCHEDULING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * All EDF tasks share the priority configEDF_PRIORITY.  Within that priority
+ * the ready task with the earliest absolute deadline runs, tasks of other
+ * priorities are scheduled as usual.  The first job is released when the task
+ * is created.  The task releases each following job by calling
+ * vTaskDelayUntil(), the deadline of the job is the wake time plus
+ * xRelativeDeadline.
+ *
+ * The task is only created if the band stays schedulable, that is if the sum
+ * of xBudget / xRelativeDeadline over all EDF tasks is not above 1.  Moving
+ * the task to another priority with vTaskPrioritySet() makes it a fixed
+ * priority task and gives its share back to the band.
+ *
+ * @param xPeriod The time in ticks between two job releases.
+ *
+ * @param xRelativeDeadline The time in ticks from the release of a job to
+ * its deadline, not more than xPeriod.
+ *
+ * @param xBudget The worst case execution time of a job in ticks, not more
+ * than xRelativeDeadline.
+ *
+ * The other parameters are the same as for xTaskCreate().
+ *
+ * @return pdPASS if the task was created, pdFAIL if it was rejected by the
+ * admission test, otherwise errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * Example usage:
+   <pre>
+ void vDecodeTask( void * pvParameters )
+ {
+ TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	 for( ;; )
+	 {
+		 // Decode one frame, this job must complete within 10 ticks.
+		 vDecodeFrame();
+
+		 // Release the next job one period after the last one.
+		 vTaskDelayUntil( &xLastWakeTime, 33 );
+	 }
+ }
+
+ void vOtherFunction( void )
+ {
+	 // Period 33 ticks, deadline 10 ticks, budget 4 ticks.
+	 xTaskCreateDeadline( vDecodeTask, "DEC", STACK_SIZE, NULL, 33, 10, 4, NULL );
+ }
+   </pre>
+ * \defgroup xTaskCreateDeadline xTaskCreateDeadline
+ * \ingroup Tasks
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+	BaseType_t xTaskCreateDeadline(	TaskFunction_t pxTaskCode,
+									const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									const TickType_t xPeriod,
+									const TickType_t xRelativeDeadline,
+									const TickType_t xBudget,
+									TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -1013,6 +1127,284 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>TaskBudgetHandle_t xTaskBudgetCreate( TickType_t xBudget, TickType_t xPeriod, eTaskBudgetAction eAction, TaskBudgetOverrunHook_t pxOverrunHook );</pre>
+ *
+ * configUSE_TASK_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * Create a CPU budget of xBudget ticks that is replenished every xPeriod
+ * ticks.  The budget is charged one tick for each tick interrupt that finds a
+ * task attached to it running.  All tasks attached to the same budget share
+ * it, so a budget can bound a single task or a group of tasks.
+ *
+ * When the budget is exhausted pxOverrunHook, if not NULL, is called from the
+ * tick interrupt and the running task is demoted or suspended as eAction
+ * says.  The other tasks of a group are throttled when they are next charged.
+ * Throttled tasks get their priority back, or are resumed, when the budget is
+ * replenished.  Budgets are never deleted.
+ *
+ * @param xBudget The run time in ticks allowed per period.
+ *
+ * @param xPeriod The replenishment period in ticks, not less than xBudget.
+ *
+ * @param eAction eTaskBudgetDemote or eTaskBudgetSuspend.  eTaskBudgetSuspend
+ * needs INCLUDE_vTaskSuspend.
+ *
+ * @param pxOverrunHook Called each time the budget is exhausted, can be NULL.
+ *
+ * @return The budget, or NULL if it could not be allocated.
+ *
+ * Example usage:
+   <pre>
+ void vCodecOverrun( TaskHandle_t xTask, TaskBudgetHandle_t xBudget )
+ {
+	 ulCodecOverruns++;
+ }
+
+ void vOtherFunction( void )
+ {
+ TaskBudgetHandle_t xCodecBudget;
+
+	 // The codec tasks may use 3 ticks out of every 10 between them.
+	 xCodecBudget = xTaskBudgetCreate( 3, 10, eTaskBudgetDemote, vCodecOverrun );
+	 vTaskBudgetAttach( xDecodeTask, xCodecBudget );
+	 vTaskBudgetAttach( xEncodeTask, xCodecBudget );
+ }
+   </pre>
+ * \defgroup xTaskBudgetCreate xTaskBudgetCreate
+ * \ingroup TaskCtrl
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TASK_BUDGET == 1 ) )
+	TaskBudgetHandle_t xTaskBudgetCreate( const TickType_t xBudget, const TickType_t xPeriod, const eTaskBudgetAction eAction, const TaskBudgetOverrunHook_t pxOverrunHook ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskBudgetAttach( TaskHandle_t xTask, TaskBudgetHandle_t xBudget );</pre>
+ *
+ * configUSE_TASK_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * Charge the run time of xTask to xBudget.  Passing NULL as xBudget detaches
+ * the task, a throttled task is then restored at once.  The idle task cannot
+ * be attached.
+ *
+ * @param xTask The task to attach.  Passing NULL attaches the calling task.
+ *
+ * @param xBudget A budget created by xTaskBudgetCreate(), or NULL.
+ *
+ * \defgroup vTaskBudgetAttach vTaskBudgetAttach
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGET == 1 )
+	void vTaskBudgetAttach( TaskHandle_t xTask, TaskBudgetHandle_t xBudget ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>TickType_t xTaskBudgetGetRemaining( TaskBudgetHandle_t xBudget );</pre>
+ *
+ * configUSE_TASK_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * @return The ticks left in the current period of xBudget.
+ *
+ * \defgroup xTaskBudgetGetRemaining xTaskBudgetGetRemaining
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGET == 1 )
+	TickType_t xTaskBudgetGetRemaining( TaskBudgetHandle_t xBudget ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be defined as 1 for this function to be
+ * available.
+ *
+ * Set the preemption threshold of a task.  Once the task has started running
+ * it can only be preempted by tasks of a priority above uxThreshold, so tasks
+ * with priorities between its own and uxThreshold do not need mutual
+ * exclusion against it.  The task still waits on events, and is woken from
+ * event lists, by its own priority.
+ *
+ * The threshold holds from the time the task is switched in until it leaves
+ * the Ready state.  A task preempted during that time runs again ahead of the
+ * ready tasks at or below its threshold.  The priority of the task does not
+ * change, uxTaskPriorityGet() reports the same priority as without the
+ * threshold.  A uxThreshold not above the priority of the task turns the
+ * threshold off, which is the default.
+ *
+ * @param xTask The task to modify.  Passing NULL modifies the calling task.
+ *
+ * @param uxThreshold The preemption threshold, below configMAX_PRIORITIES.
+ *
+ * Example usage:
+   <pre>
+ void vParseTask( void * pvParameters )
+ {
+	 // The decode task, priority 3, cannot preempt the parser while it
+	 // works on a frame the decoder also reads.  The USB task, priority 5,
+	 // still can.
+	 vTaskPreemptionThresholdSet( NULL, 3 );
+
+	 for( ;; )
+	 {
+		 // Parser work.
+	 }
+ }
+   </pre>
+ * \defgroup vTaskPreemptionThresholdSet vTaskPreemptionThresholdSet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The task to query.  Passing NULL queries the calling task.
+ *
+ * @return The preemption threshold set by vTaskPreemptionThresholdSet(), 0 if
+ * none was set.
+ *
+ * \defgroup uxTaskPreemptionThresholdGet uxTaskPreemptionThresholdGet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks );</pre>
+ *
+ * configUSE_TASK_TIME_SLICE must be defined as 1 for this function to be
+ * available.  It only has an effect when configUSE_PREEMPTION and
+ * configUSE_TIME_SLICING are 1.
+ *
+ * Set the round robin quantum of a task.  The task is only switched out in
+ * favour of a task of the same priority once it has run for xTicks ticks
+ * while such a task was ready.  What is left of the quantum is kept when the
+ * task blocks.  New tasks start with configDEFAULT_TIME_SLICE ticks.
+ *
+ * @param xTask The task to modify.  Passing NULL modifies the calling task.
+ *
+ * @param xTicks The quantum in ticks, at least 1.
+ *
+ * Example usage:
+   <pre>
+ void vBatchTask( void * pvParameters )
+ {
+	 // Share the priority with the other batch tasks 20 ticks at a time.
+	 vTaskSetTimeSlice( NULL, 20 );
+
+	 for( ;; )
+	 {
+		 // Batch work.
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetTimeSlice vTaskSetTimeSlice
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_TIME_SLICE == 1 )
+	void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskPartitionScheduleSet( const PartitionWindow_t * const pxWindows, UBaseType_t uxWindowCount );</pre>
+ *
+ * configUSE_PARTITIONS must be defined as 1 for this function to be
+ * available.  It must be called before the scheduler is started.
+ *
+ * Install the static cyclic schedule of the partitions.  The major frame is
+ * the sequence of the uxWindowCount windows in pxWindows, repeated for ever
+ * from the first window.  Inside a window the tasks of the partition that
+ * owns it, and the tasks of the system partition 0, are scheduled by priority
+ * as usual.  Tasks of the other partitions do not run, whatever their
+ * priority, so each partition gets the CPU share of its windows.
+ *
+ * If configPARTITION_BACKGROUND is not 0, that partition also runs whenever
+ * the window owner has no ready task.  It gives the CPU back within one tick
+ * of a task of the window owner becoming ready.
+ *
+ * Until a schedule is installed all partitions run.  The array is used in
+ * place and must stay valid.
+ *
+ * @param pxWindows The windows of the major frame.
+ *
+ * @param uxWindowCount The number of windows in pxWindows.
+ *
+ * Example usage:
+   <pre>
+ // 10 ticks of power management, then 30 ticks of features.
+ static const PartitionWindow_t xFrame[] = { { 1, 10 }, { 2, 30 } };
+
+ void main( void )
+ {
+	 xTaskCreate( vPowerTask, "PWR", STACK_SIZE, NULL, 3, &xPowerTask );
+	 xTaskCreate( vFeatureTask, "FEAT", STACK_SIZE, NULL, 5, &xFeatureTask );
+	 vTaskSetPartition( xPowerTask, 1 );
+	 vTaskSetPartition( xFeatureTask, 2 );
+	 vTaskPartitionScheduleSet( xFrame, 2 );
+	 vTaskStartScheduler();
+ }
+   </pre>
+ * \defgroup vTaskPartitionScheduleSet vTaskPartitionScheduleSet
+ * \ingroup SchedulerControl
+ */
+#if ( configUSE_PARTITIONS == 1 )
+	void vTaskPartitionScheduleSet( const PartitionWindow_t * const pxWindows, UBaseType_t uxWindowCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskSetPartition( TaskHandle_t xTask, UBaseType_t uxPartition );</pre>
+ *
+ * configUSE_PARTITIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * Move a task to a partition.  Tasks start in the system partition 0, which
+ * runs in every window.
+ *
+ * @param xTask The task to move.  Passing NULL moves the calling task.
+ *
+ * @param uxPartition The partition, below configNUM_PARTITIONS.
+ *
+ * \defgroup vTaskSetPartition vTaskSetPartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PARTITIONS == 1 )
+	void vTaskSetPartition( TaskHandle_t xTask, UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskGetActivePartition( void );</pre>
+ *
+ * configUSE_PARTITIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * @return The partition that owns the current window, 0 if no schedule is
+ * installed.
+ *
+ * \defgroup uxTaskGetActivePartition uxTaskGetActivePartition
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_PARTITIONS == 1 )
+	UBaseType_t uxTaskGetActivePartition( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -1769,7 +2161,8 @@ TickType_t xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );
+ BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1777,6 +2170,13 @@ TickType_t xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES such
+ * notification values, each with its own pending state, so independent users
+ * of notifications on the same task do not see each other's notifications.
+ * xTaskNotify() uses index tskDEFAULT_INDEX_TO_NOTIFY, xTaskNotifyIndexed()
+ * takes the index as its second parameter.  A task waiting on one index is
+ * only unblocked by notifications sent to that index.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1805,6 +2205,9 @@ TickType_t xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify xTaskNotifyIndexed() only.  The index of the
+ * notification value to act on, below configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1846,13 +2249,16 @@ TickType_t xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );
+ BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1937,13 +2343,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
+ BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2014,11 +2423,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWait, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWait ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );
+ BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2060,11 +2472,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2115,11 +2529,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
- * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
+ uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2184,11 +2601,14 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWait, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWait ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+ BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
@@ -2200,7 +2620,9 @@ uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2297,6 +2719,57 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that can be called with
+ * interrupts masked, including from an ISR, for event groups that are set
+ * directly from interrupts.  If the scheduler is suspended the task is held
+ * on the pending ready list, as xTaskRemoveFromEventList() does.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE QUEUE IMPLEMENTATION.
+ *
+ * A task about to block in xQueueReceive() registers its receive buffer with
+ * vTaskSetHandoffBuffer().  A sender that finds it at the head of the list of
+ * waiting receivers takes the buffer with pvTaskTakeHandoffBuffer(), with
+ * interrupts masked, and copies the item straight into it.  Once unblocked the
+ * receiver calls xTaskHandoffCompleted(), which returns pdTRUE if its buffer
+ * was taken and clears it otherwise.
+ */
+#if( configUSE_QUEUE_HANDOFF == 1 )
+	void vTaskSetHandoffBuffer( void * const pvBuffer ) PRIVILEGED_FUNCTION;
+	void *pvTaskTakeHandoffBuffer( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+	BaseType_t xTaskHandoffCompleted( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * vTaskMoveToMutexEventList() moves the highest priority task on one event
+ * list to the event list of the tasks waiting for a mutex without unblocking
+ * it, so it goes on waiting, with the same timeout, for the mutex, and makes
+ * the holder of the mutex inherit its priority.  It must be called with the
+ * scheduler suspended.  Condition variables use it to move signalled waiters
+ * straight onto their mutex.  Once unblocked, the moved task calls
+ * xTaskMovedToMutex(), which returns pdTRUE if it was moved and clears the
+ * record of it.
+ */
+#if( configUSE_MUTEXES == 1 )
+	void vTaskMoveToMutexEventList( const List_t * const pxFromEventList, void * const pvMutex, List_t * const pxMutexEventList, TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+	BaseType_t xTaskMovedToMutex( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -2406,6 +2879,35 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task
+ * when a lock is given without waiters, without a critical section.  Returns
+ * pdTRUE, and leaves the count alone, if the count would drop to zero while
+ * the task runs above its base priority.  The caller must then give the
+ * priority back with xTaskPriorityDisinherit().
+ */
+BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Raise the priority of the calling task to the
+ * ceiling of a mutex it has just taken.  The priority is restored by
+ * xTaskPriorityDisinherit().
+ */
+void vTaskPriorityCeilingRaise( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  The configUSE_TRANSITIVE_INHERITANCE versions of
+ * pvTaskIncrementMutexHeldCount(), xTaskPriorityInherit(),
+ * xTaskPriorityDisinherit() and vTaskPriorityDisinheritAfterTimeout().  Each
+ * task keeps the list of mutexes it holds and the mutex it is blocked on, so
+ * inheritance follows the chain of mutex holders and the priority of a holder
+ * is recomputed from the mutexes it still holds.
+ */
+TaskHandle_t pvTaskMutexTaken( ListItem_t * const pxMutexHeldListItem ) PRIVILEGED_FUNCTION;
+void vTaskMutexInherit( void * const pvMutex, TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskMutexDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+void vTaskMutexDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include topic.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A topic broadcasts samples, such as sensor readings or state updates, from
+ * publishers to any number of subscribers.  Each sample is copied once into a
+ * ring of the last uxDepth samples, and each subscriber keeps its own read
+ * position in the ring, so publishing costs the same whatever the number of
+ * subscribers, apart from unblocking the subscribers that wait for a sample.
+ *
+ * A subscriber reads in one of three modes:
+ *
+ * eTopicReadLatest - each read returns the newest sample the subscriber has
+ * not read, skipping older ones.  For state that only the current value of
+ * matters.
+ *
+ * eTopicReadAll - each read returns the oldest sample the subscriber has not
+ * read, so every sample is read in order while the subscriber keeps up.
+ * Publishing does not wait for these subscribers: one that falls more than
+ * uxDepth samples behind loses the oldest samples.
+ *
+ * eTopicReadLossless - as eTopicReadAll, but no sample is ever lost.  While a
+ * lossless subscriber has uxDepth samples it has not read, xTopicPublish()
+ * waits for it to read one, or fails with errQUEUE_FULL, and
+ * xTopicPublishFromISR() fails.  A slow lossless subscriber therefore slows
+ * every publisher down to its own rate.
+ *
+ * In the first two modes the samples skipped are counted in the overrun counter of the
+ * subscriber, see ulTopicGetOverruns().  A new subscriber can read the last
+ * sample published before it subscribed.
+ *
+ * Samples can be published from interrupts.  Each subscriber must be read by
+ * one task at a time.
+ *
+ * \defgroup Topic
+ */
+
+/**
+ * topic.h
+ *
+ * Types by which topics and their subscribers are referenced.
+ *
+ * \defgroup TopicHandle_t TopicHandle_t
+ * \ingroup Topic
+ */
+struct TopicDef_t;
+typedef struct TopicDef_t * TopicHandle_t;
+
+struct TopicSubscriberDef_t;
+typedef struct TopicSubscriberDef_t * TopicSubscriberHandle_t;
+
+/**
+ * How a subscriber reads a topic, see the description of topics above.
+ */
+typedef enum
+{
+	eTopicReadLatest = 0,
+	eTopicReadAll,
+	eTopicReadLossless
+} eTopicReadMode;
+
+/**
+ * topic.h
+ *<pre>
+ TopicHandle_t xTopicCreate( UBaseType_t uxDepth, UBaseType_t uxSampleSize );
+ </pre>
+ *
+ * Create a new topic, allocating it with pvPortMalloc().
+ *
+ * @param uxDepth The number of samples the topic keeps.
+ *
+ * @param uxSampleSize The size in bytes of each sample, which must not be 0.
+ *
+ * @return A handle to the topic, or NULL if there was not enough heap.
+ *
+ * \defgroup xTopicCreate xTopicCreate
+ * \ingroup Topic
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	TopicHandle_t xTopicCreate( UBaseType_t uxDepth, UBaseType_t uxSampleSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *<pre>
+ TopicHandle_t xTopicCreateStatic( UBaseType_t uxDepth,
+                                   UBaseType_t uxSampleSize,
+                                   uint8_t *pucTopicStorageBuffer,
+                                   StaticTopic_t *pxTopicBuffer );
+ </pre>
+ *
+ * Create a new topic in memory provided by the application writer.
+ *
+ * @param uxDepth The number of samples the topic keeps.
+ *
+ * @param uxSampleSize The size in bytes of each sample, which must not be 0.
+ *
+ * @param pucTopicStorageBuffer A buffer of at least uxDepth * uxSampleSize
+ * bytes.
+ *
+ * @param pxTopicBuffer Must point to a variable of type StaticTopic_t, which
+ * will be used to hold the topic structure.
+ *
+ * @return A handle to the topic, or NULL if pxTopicBuffer was NULL.
+ *
+ * \defgroup xTopicCreateStatic xTopicCreateStatic
+ * \ingroup Topic
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	TopicHandle_t xTopicCreateStatic( UBaseType_t uxDepth, UBaseType_t uxSampleSize, uint8_t *pucTopicStorageBuffer, StaticTopic_t *pxTopicBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *<pre>
+ TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic, eTopicReadMode eMode );
+ </pre>
+ *
+ * Create a subscriber of a topic, allocating it with pvPortMalloc().
+ *
+ * @param xTopic The topic to subscribe to.
+ *
+ * @param eMode How the subscriber reads the topic.
+ *
+ * @return A handle to the subscriber, or NULL if there was not enough heap.
+ *
+ * \defgroup xTopicSubscribe xTopicSubscribe
+ * \ingroup Topic
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic, eTopicReadMode eMode ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *<pre>
+ TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic, eTopicReadMode eMode, StaticTopicSubscriber_t *pxSubscriberBuffer );
+ </pre>
+ *
+ * Create a subscriber of a topic in memory provided by the application
+ * writer.
+ *
+ * @param pxSubscriberBuffer Must point to a variable of type
+ * StaticTopicSubscriber_t, which will be used to hold the subscriber
+ * structure.
+ *
+ * @return A handle to the subscriber, or NULL if pxSubscriberBuffer was NULL.
+ *
+ * \defgroup xTopicSubscribeStatic xTopicSubscribeStatic
+ * \ingroup Topic
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic, eTopicReadMode eMode, StaticTopicSubscriber_t *pxSubscriberBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *<pre>
+ void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber );
+ </pre>
+ *
+ * Delete a subscriber.  No task can be waiting in xTopicReceive() on it.  If
+ * the subscriber is lossless, tasks waiting to publish are unblocked.
+ *
+ * \defgroup vTopicUnsubscribe vTopicUnsubscribe
+ * \ingroup Topic
+ */
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ BaseType_t xTopicPublish( TopicHandle_t xTopic, const void * const pvSample, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Copy a sample into a topic, overwriting the oldest sample, and unblock every
+ * task waiting for a sample.  If a lossless subscriber has not read the oldest
+ * sample yet, wait up to xTicksToWait ticks for it to be read first.
+ *
+ * @param xTopic The topic to publish to.
+ *
+ * @param pvSample A pointer to the sample to copy into the topic.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * lossless subscriber.  A topic without lossless subscribers never waits.
+ *
+ * @return pdPASS if the sample was published, errQUEUE_FULL if xTicksToWait
+ * expired first.
+ *
+ * Example usage:
+ <pre>
+ TopicHandle_t xAttitudeTopic;
+
+ void vImuTask( void *pvParameters )
+ {
+ Attitude_t xAttitude;
+
+    for( ;; )
+    {
+        vReadImu( &xAttitude );
+        xTopicPublish( xAttitudeTopic, &xAttitude, portMAX_DELAY );
+    }
+ }
+
+ void vDisplayTask( void *pvParameters )
+ {
+ TopicSubscriberHandle_t xSubscriber = xTopicSubscribe( xAttitudeTopic, eTopicReadLatest );
+ Attitude_t xAttitude;
+
+    for( ;; )
+    {
+        if( xTopicReceive( xSubscriber, &xAttitude, pdMS_TO_TICKS( 100 ) ) == pdPASS )
+        {
+            vDrawHorizon( &xAttitude );
+        }
+    }
+ }
+
+ void vLoggerTask( void *pvParameters )
+ {
+ TopicSubscriberHandle_t xSubscriber = xTopicSubscribe( xAttitudeTopic, eTopicReadLossless );
+ Attitude_t xAttitude;
+
+    for( ;; )
+    {
+        // vImuTask waits for this task rather than overwrite a sample it has
+        // not logged.
+        xTopicReceive( xSubscriber, &xAttitude, portMAX_DELAY );
+        vLog( &xAttitude );
+    }
+ }
+ </pre>
+ * \defgroup xTopicPublish xTopicPublish
+ * \ingroup Topic
+ */
+BaseType_t xTopicPublish( TopicHandle_t xTopic, const void * const pvSample, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ void vTopicPublish( TopicHandle_t xTopic, const void * const pvSample );
+ </pre>
+ *
+ * Publish a sample with xTopicPublish(), waiting for as long as it takes for
+ * lossless subscribers.
+ *
+ * \defgroup vTopicPublish vTopicPublish
+ * \ingroup Topic
+ */
+void vTopicPublish( TopicHandle_t xTopic, const void * const pvSample ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xTopicPublish() that can be called from an interrupt service
+ * routine.  It cannot wait, so it fails if a lossless subscriber has not read
+ * the oldest sample.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if publishing the sample
+ * unblocked a task with a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the sample was published, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xTopicPublishFromISR xTopicPublishFromISR
+ * \ingroup Topic
+ */
+BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ void vTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * xTopicPublishFromISR() without the result, for topics without lossless
+ * subscribers.  On a topic with one the sample is dropped if it does not fit.
+ *
+ * \defgroup vTopicPublishFromISR vTopicPublishFromISR
+ * \ingroup Topic
+ */
+void vTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void * const pvBuffer, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Copy the next sample for a subscriber into pvBuffer, as chosen by the mode
+ * of the subscriber, waiting up to xTicksToWait ticks for a sample to be
+ * published if the subscriber has read them all.
+ *
+ * @param xSubscriber The subscriber to read for.
+ *
+ * @param pvBuffer A buffer of the sample size of the topic.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdPASS if a sample was read, errQUEUE_EMPTY if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xTopicReceive xTopicReceive
+ * \ingroup Topic
+ */
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ uint32_t ulTopicGetOverruns( TopicSubscriberHandle_t xSubscriber );
+ </pre>
+ *
+ * @return The number of samples a subscriber has skipped since it subscribed,
+ * either because it reads the latest sample only or because it fell more than
+ * the depth of the topic behind.  Always 0 for a lossless subscriber.
+ *
+ * \defgroup ulTopicGetOverruns ulTopicGetOverruns
+ * \ingroup Topic
+ */
+uint32_t ulTopicGetOverruns( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *<pre>
+ void vTopicDelete( TopicHandle_t xTopic );
+ </pre>
+ *
+ * Delete a topic.  All its subscribers must have been deleted.
+ *
+ * \defgroup vTopicDelete vTopicDelete
+ * \ingroup Topic
+ */
+void vTopicDelete( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_H */
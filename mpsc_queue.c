@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "mpsc_queue.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_MPSC_QUEUES == 1 )
+
+#if ( configUSE_TASK_NOTIFICATIONS == 0 ) || ( ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_MUTEXES == 0 ) )
+	#error configUSE_MPSC_QUEUES needs configUSE_TASK_NOTIFICATIONS, and configUSE_MUTEXES or INCLUDE_xTaskGetCurrentTaskHandle.
+#endif
+
+/* Each slot holds a sequence number followed by the item.  A slot is free for
+the sender that reserves write position ulPosition while its sequence number is
+ulPosition, and holds the item for read position ulPosition once the sequence
+number is ulPosition + 1.  The receiver frees it for the next lap by setting
+the sequence number to ulPosition + uxLength.  Positions count up freely, so
+the length must be a power of 2 for the slot index to survive the wrap. */
+#define mpscqueueHEADER_SIZE			sizeof( uint32_t )
+#define mpscqueueSLOT_SIZE( uxItemSize )	( ( mpscqueueHEADER_SIZE + ( size_t ) ( uxItemSize ) + sizeof( uint32_t ) - 1U ) & ~( sizeof( uint32_t ) - 1U ) )
+
+#define mpscqueueSLOT( pxQueue, ulPosition )		( &( ( pxQueue )->pucStorage[ ( size_t ) ( ( ulPosition ) & ( pxQueue )->ulMask ) * ( pxQueue )->xSlotSize ] ) )
+#define mpscqueueSEQUENCE( pucSlot )			( *( ( volatile uint32_t * ) ( pucSlot ) ) ) /*lint !e9087 !e826 Slots are 32 bit aligned. */
+
+/* portMEMORY_BARRIER() only stops the compiler reordering accesses, and is
+empty on some ports.  The item copy must also be seen by the other core or bus
+master in order with the sequence number, so the sequence number is published
+after a release fence and read before an acquire fence. */
+#define mpscqueueRELEASE_FENCE()	__atomic_thread_fence( __ATOMIC_RELEASE )
+#define mpscqueueACQUIRE_FENCE()	__atomic_thread_fence( __ATOMIC_ACQUIRE )
+#define mpscqueueFULL_FENCE()		__atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+typedef struct MPSCQueueDef_t
+{
+	volatile uint32_t ulWritePosition;	/*< The next position a sender reserves, only changed by compare-and-swap. */
+	uint32_t ulReadPosition;			/*< The next position the receiver reads, only accessed by the receiver. */
+	uint32_t ulMask;					/*< The queue length - 1. */
+	size_t xSlotSize;					/*< The size of a slot, the item rounded up to 32 bits plus the sequence number. */
+	UBaseType_t uxItemSize;				/*< The size of each item. */
+	uint8_t *pucStorage;				/*< The slots. */
+	void * volatile pvReceiver;			/*< The handle of the receiving task while it is about to block or blocked, otherwise NULL. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the queue is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} MPSCQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a queue that has been allocated.
+ */
+static void prvInitialiseMPSCQueue( MPSCQueue_t * const pxQueue, const UBaseType_t uxLength, const UBaseType_t uxItemSize, uint8_t * const pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reserve a slot, copy the item in and publish it.  On success *pxReceiver is
+ * set to the receiving task if it has to be unblocked, otherwise to NULL.
+ */
+static BaseType_t prvMPSCQueueWrite( MPSCQueue_t * const pxQueue, const void * const pvItemToQueue, TaskHandle_t * const pxReceiver ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy out and free the item at the read position if its sender has published
+ * it.  Returns pdFALSE if there is no such item.
+ */
+static BaseType_t prvMPSCQueueRead( MPSCQueue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	MPSCQueueHandle_t xMPSCQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorageBuffer, StaticMPSCQueue_t *pxMPSCQueueBuffer )
+	{
+	MPSCQueue_t *pxQueue;
+
+		configASSERT( pxMPSCQueueBuffer );
+		configASSERT( pucQueueStorageBuffer );
+		configASSERT( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorageBuffer & ( sizeof( uint32_t ) - 1U ) ) == 0U );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticMPSCQueue_t equals the size of the real queue
+			structure. */
+			volatile size_t xSize = sizeof( StaticMPSCQueue_t );
+			configASSERT( xSize == sizeof( MPSCQueue_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxQueue = ( MPSCQueue_t * ) pxMPSCQueueBuffer; /*lint !e740 !e9087 MPSCQueue_t and StaticMPSCQueue_t are deliberately aliased for data hiding purposes. */
+
+		if( pxQueue != NULL )
+		{
+			prvInitialiseMPSCQueue( pxQueue, uxLength, uxItemSize, pucQueueStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceMPSC_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			traceMPSC_QUEUE_CREATE_FAILED();
+		}
+
+		return pxQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MPSCQueueHandle_t xMPSCQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize )
+	{
+	MPSCQueue_t *pxQueue;
+
+		/* The storage area follows the structure, which pvPortMalloc() aligns
+		for any type and which is a multiple of 32 bits long. */
+		pxQueue = ( MPSCQueue_t * ) pvPortMalloc( sizeof( MPSCQueue_t ) + mpscqueueSTORAGE_SIZE( uxLength, uxItemSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxQueue != NULL )
+		{
+			prvInitialiseMPSCQueue( pxQueue, uxLength, uxItemSize, ( ( uint8_t * ) pxQueue ) + sizeof( MPSCQueue_t ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceMPSC_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			traceMPSC_QUEUE_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxQueue;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseMPSCQueue( MPSCQueue_t * const pxQueue, const UBaseType_t uxLength, const UBaseType_t uxItemSize, uint8_t * const pucStorage )
+{
+uint32_t ulPosition;
+
+	/* The length must be a power of 2, see mpscqueueSLOT(). */
+	configASSERT( ( uxLength != 0U ) && ( ( uxLength & ( uxLength - 1U ) ) == 0U ) );
+	configASSERT( uxItemSize != 0U );
+
+	pxQueue->ulWritePosition = 0U;
+	pxQueue->ulReadPosition = 0U;
+	pxQueue->ulMask = ( uint32_t ) uxLength - 1U;
+	pxQueue->xSlotSize = mpscqueueSLOT_SIZE( uxItemSize );
+	pxQueue->uxItemSize = uxItemSize;
+	pxQueue->pucStorage = pucStorage;
+	pxQueue->pvReceiver = NULL;
+
+	for( ulPosition = 0U; ulPosition < ( uint32_t ) uxLength; ulPosition++ )
+	{
+		mpscqueueSEQUENCE( mpscqueueSLOT( pxQueue, ulPosition ) ) = ulPosition;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMPSCQueueSend( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue )
+{
+MPSCQueue_t * const pxQueue = xQueue;
+TaskHandle_t xReceiver;
+BaseType_t xReturn;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemToQueue );
+
+	xReturn = prvMPSCQueueWrite( pxQueue, pvItemToQueue, &xReceiver );
+
+	if( xReturn == pdPASS )
+	{
+		traceMPSC_QUEUE_SEND( pxQueue );
+
+		if( xReceiver != NULL )
+		{
+			( void ) xTaskGenericNotify( xReceiver, configMPSC_QUEUE_NOTIFY_INDEX, 0, eIncrement, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		traceMPSC_QUEUE_SEND_FAILED( pxQueue );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMPSCQueueSendFromISR( MPSCQueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MPSCQueue_t * const pxQueue = xQueue;
+TaskHandle_t xReceiver;
+BaseType_t xReturn;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemToQueue );
+
+	xReturn = prvMPSCQueueWrite( pxQueue, pvItemToQueue, &xReceiver );
+
+	if( xReturn == pdPASS )
+	{
+		traceMPSC_QUEUE_SEND_FROM_ISR( pxQueue );
+
+		if( xReceiver != NULL )
+		{
+			vTaskGenericNotifyGiveFromISR( xReceiver, configMPSC_QUEUE_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		traceMPSC_QUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMPSCQueueReceive( MPSCQueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+{
+MPSCQueue_t * const pxQueue = xQueue;
+BaseType_t xReturn = errQUEUE_EMPTY, xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		if( prvMPSCQueueRead( pxQueue, pvBuffer ) != pdFALSE )
+		{
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				break;
+			}
+			else
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+		}
+		else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Publish the receiver before looking at the queue again.  A sender
+		that published its item after the look above either finds the receiver
+		and notifies it, or published before the look below and its item is
+		found there.  A notification left over from a sender that took the
+		receiver after the item was found only causes a spurious wake. */
+		( void ) Atomic_SwapPointers_p32( &( pxQueue->pvReceiver ), xTaskGetCurrentTaskHandle() );
+		mpscqueueFULL_FENCE();
+
+		if( prvMPSCQueueRead( pxQueue, pvBuffer ) != pdFALSE )
+		{
+			( void ) Atomic_SwapPointers_p32( &( pxQueue->pvReceiver ), NULL );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceBLOCKING_ON_MPSC_QUEUE_RECEIVE( pxQueue );
+		( void ) ulTaskGenericNotifyTake( configMPSC_QUEUE_NOTIFY_INDEX, pdTRUE, xTicksToWait );
+		( void ) Atomic_SwapPointers_p32( &( pxQueue->pvReceiver ), NULL );
+	}
+
+	if( xReturn == pdPASS )
+	{
+		traceMPSC_QUEUE_RECEIVE( pxQueue );
+	}
+	else
+	{
+		traceMPSC_QUEUE_RECEIVE_FAILED( pxQueue );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMPSCQueueMessagesWaiting( MPSCQueueHandle_t xQueue )
+{
+const MPSCQueue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	return ( UBaseType_t ) ( pxQueue->ulWritePosition - pxQueue->ulReadPosition );
+}
+/*-----------------------------------------------------------*/
+
+void vMPSCQueueDelete( MPSCQueueHandle_t xQueue )
+{
+MPSCQueue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->pvReceiver == NULL );
+
+	traceMPSC_QUEUE_DELETE( pxQueue );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMPSCQueueWrite( MPSCQueue_t * const pxQueue, const void * const pvItemToQueue, TaskHandle_t * const pxReceiver )
+{
+uint32_t ulPosition;
+int32_t lDifference;
+uint8_t *pucSlot;
+BaseType_t xReturn = errQUEUE_FULL;
+
+	*pxReceiver = NULL;
+	ulPosition = pxQueue->ulWritePosition;
+
+	for( ;; )
+	{
+		pucSlot = mpscqueueSLOT( pxQueue, ulPosition );
+		lDifference = ( int32_t ) ( mpscqueueSEQUENCE( pucSlot ) - ulPosition );
+
+		if( lDifference == 0 )
+		{
+			/* The slot is free.  The compare-and-swap only fails if another
+			sender reserved it first, then try the next position. */
+			if( Atomic_CompareAndSwap_u32( &( pxQueue->ulWritePosition ), ulPosition + 1U, ulPosition ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+			{
+				xReturn = pdPASS;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( lDifference < 0 )
+		{
+			/* The slot still holds the item from the previous lap, so the
+			queue is full. */
+			break;
+		}
+		else
+		{
+			/* Another sender reserved the slot after ulPosition was read. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		ulPosition = pxQueue->ulWritePosition;
+	}
+
+	if( xReturn == pdPASS )
+	{
+		/* Only this sender accesses the slot until the sequence number is
+		updated, so the copy and the update need no lock, only to be kept in
+		order.  The acquire fence keeps the copy after the read of the
+		sequence number that showed the receiver had finished with the slot.
+		The full fence keeps the update before the look at the receiver,
+		which xMPSCQueueReceive() publishes before looking at the slot. */
+		mpscqueueACQUIRE_FENCE();
+		( void ) memcpy( ( void * ) &( pucSlot[ mpscqueueHEADER_SIZE ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		mpscqueueRELEASE_FENCE();
+		mpscqueueSEQUENCE( pucSlot ) = ulPosition + 1U;
+		mpscqueueFULL_FENCE();
+
+		/* Take the receiver so only one sender notifies it. */
+		if( pxQueue->pvReceiver != NULL )
+		{
+			*pxReceiver = ( TaskHandle_t ) Atomic_SwapPointers_p32( &( pxQueue->pvReceiver ), NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMPSCQueueRead( MPSCQueue_t * const pxQueue, void * const pvBuffer )
+{
+uint32_t const ulPosition = pxQueue->ulReadPosition;
+uint8_t * const pucSlot = mpscqueueSLOT( pxQueue, ulPosition );
+BaseType_t xReturn;
+
+	if( mpscqueueSEQUENCE( pucSlot ) == ( ulPosition + 1U ) )
+	{
+		mpscqueueACQUIRE_FENCE();
+		( void ) memcpy( pvBuffer, ( void * ) &( pucSlot[ mpscqueueHEADER_SIZE ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		mpscqueueRELEASE_FENCE();
+
+		/* Free the slot for the sender that reserves it on the next lap. */
+		mpscqueueSEQUENCE( pucSlot ) = ulPosition + pxQueue->ulMask + 1U;
+		pxQueue->ulReadPosition = ulPosition + 1U;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		/* Empty, or the sender of the next item is still copying it in. */
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+
+#endif /* configUSE_MPSC_QUEUES */
@@ -0,0 +1,582 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "poll_set.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_POLL_SETS == 1 )
+
+#define pollMEMBER_BIT( uxMember )	( ( uint32_t ) 1UL << ( uxMember ) )
+
+#if( configUSE_PREEMPTION == 0 )
+	#define pollYIELD_IF_USING_PREEMPTION()
+#else
+	#define pollYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+typedef struct PollMemberDef_t
+{
+	void *pvObject;						/*< The handle of the object, as passed to xPollSetAdd(). */
+	void *pvUserData;					/*< Returned with the object by uxPollSetWait(). */
+	struct PollSetDef_t *pxPollSet;		/*< The set the member belongs to. */
+	EventBits_t uxEvents;				/*< The event group bits of interest, all bits for other objects. */
+	uint8_t ucType;						/*< The ePollObjectType of the object. */
+	uint8_t ucEdgeTriggered;			/*< pdTRUE if the member is reported once per write, pdFALSE if while the object is ready. */
+} PollMember_t;
+
+typedef struct PollSetDef_t
+{
+	volatile uint32_t ulReady;			/*< One bit per member that may be ready.  Set by the objects with interrupts masked. */
+	uint32_t ulMembers;					/*< One bit per entry of xMembers in use. */
+	List_t xTasksWaiting;				/*< Tasks blocked in uxPollSetWait(), in priority order. */
+	UBaseType_t uxNextMember;			/*< Where the next uxPollSetWait() starts looking, so all members get reported. */
+	PollMember_t xMembers[ configPOLL_SET_MAX_MEMBERS ];
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the poll set is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} PollSet_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a new poll set.
+ */
+static void prvInitialiseNewPollSet( PollSet_t *pxPollSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record or clear pxMember in its object.
+ */
+static BaseType_t prvSetObjectMember( const PollMember_t * const pxMember, PollMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return pdTRUE if the object of pxMember can be read from now.
+ */
+static BaseType_t prvObjectIsReady( const PollMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write up to uxMaxEvents ready members to pxEvents and return how many were
+ * written.
+ */
+static UBaseType_t prvCollectReadyMembers( PollSet_t * const pxPollSet, PollEvent_t * const pxEvents, const UBaseType_t uxMaxEvents ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t *pxPollSetBuffer )
+	{
+	PollSet_t *pxPollSet;
+
+		configASSERT( pxPollSetBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticPollSet_t equals the size of the real poll
+			set structure. */
+			volatile size_t xSize = sizeof( StaticPollSet_t );
+			configASSERT( xSize == sizeof( PollSet_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxPollSet = ( PollSet_t * ) pxPollSetBuffer; /*lint !e740 !e9087 PollSet_t and StaticPollSet_t are deliberately aliased for data hiding purposes. */
+
+		if( pxPollSet != NULL )
+		{
+			prvInitialiseNewPollSet( pxPollSet );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxPollSet->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			tracePOLL_SET_CREATE( pxPollSet );
+		}
+		else
+		{
+			tracePOLL_SET_CREATE_FAILED();
+		}
+
+		return pxPollSet;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PollSetHandle_t xPollSetCreate( void )
+	{
+	PollSet_t *pxPollSet;
+
+		pxPollSet = ( PollSet_t * ) pvPortMalloc( sizeof( PollSet_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxPollSet != NULL )
+		{
+			prvInitialiseNewPollSet( pxPollSet );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxPollSet->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			tracePOLL_SET_CREATE( pxPollSet );
+		}
+		else
+		{
+			tracePOLL_SET_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxPollSet;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xPollSetAdd( PollSetHandle_t xPollSet, ePollObjectType eType, void *pvObject, EventBits_t uxEvents, BaseType_t xTrigger, void *pvUserData )
+{
+PollSet_t * const pxPollSet = xPollSet;
+PollMember_t *pxMember = NULL;
+UBaseType_t uxMember;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxPollSet );
+	configASSERT( pvObject );
+	configASSERT( eType <= ePollTaskNotification );
+	configASSERT( ( eType != ePollEventGroup ) || ( uxEvents != ( EventBits_t ) 0 ) );
+
+	/* Claim a free entry.  Objects only look at an entry once it is recorded
+	in them, so it can be filled in outside the critical section. */
+	taskENTER_CRITICAL();
+	{
+		for( uxMember = 0U; uxMember < ( UBaseType_t ) configPOLL_SET_MAX_MEMBERS; uxMember++ )
+		{
+			if( ( pxPollSet->ulMembers & pollMEMBER_BIT( uxMember ) ) == 0UL )
+			{
+				pxPollSet->ulMembers |= pollMEMBER_BIT( uxMember );
+				pxMember = &( pxPollSet->xMembers[ uxMember ] );
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( pxMember != NULL )
+	{
+		pxMember->pvObject = pvObject;
+		pxMember->pvUserData = pvUserData;
+		pxMember->pxPollSet = pxPollSet;
+		pxMember->uxEvents = ( eType == ePollEventGroup ) ? uxEvents : pollOBJECT_WRITTEN;
+		pxMember->ucType = ( uint8_t ) eType;
+		pxMember->ucEdgeTriggered = ( uint8_t ) ( ( xTrigger != pollLEVEL_TRIGGERED ) ? pdTRUE : pdFALSE );
+
+		xReturn = prvSetObjectMember( pxMember, pxMember );
+
+		if( xReturn != pdFAIL )
+		{
+			tracePOLL_SET_ADD( pxPollSet, pvObject );
+
+			/* Report an object that is ready already. */
+			if( prvObjectIsReady( pxMember ) != pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					if( xPollSetSignal( pxMember, pollOBJECT_WRITTEN ) != pdFALSE )
+					{
+						pollYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* The object is a member of a poll set already. */
+			taskENTER_CRITICAL();
+			{
+				pxPollSet->ulMembers &= ~pollMEMBER_BIT( uxMember );
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPollSetRemove( PollSetHandle_t xPollSet, void *pvObject )
+{
+PollSet_t * const pxPollSet = xPollSet;
+UBaseType_t uxMember;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxPollSet );
+
+	for( uxMember = 0U; uxMember < ( UBaseType_t ) configPOLL_SET_MAX_MEMBERS; uxMember++ )
+	{
+		if( ( ( pxPollSet->ulMembers & pollMEMBER_BIT( uxMember ) ) != 0UL ) && ( pxPollSet->xMembers[ uxMember ].pvObject == pvObject ) )
+		{
+			/* Once the object has forgotten the entry it no longer sets its
+			bit, so the entry can be freed. */
+			( void ) prvSetObjectMember( &( pxPollSet->xMembers[ uxMember ] ), NULL );
+
+			taskENTER_CRITICAL();
+			{
+				pxPollSet->ulReady &= ~pollMEMBER_BIT( uxMember );
+				pxPollSet->ulMembers &= ~pollMEMBER_BIT( uxMember );
+			}
+			taskEXIT_CRITICAL();
+
+			tracePOLL_SET_REMOVE( pxPollSet, pvObject );
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPollSetWait( PollSetHandle_t xPollSet, PollEvent_t * const pxEvents, const UBaseType_t uxMaxEvents, TickType_t xTicksToWait )
+{
+PollSet_t * const pxPollSet = xPollSet;
+UBaseType_t uxCount;
+BaseType_t xEntryTimeSet = pdFALSE, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxPollSet );
+	configASSERT( pxEvents );
+	configASSERT( uxMaxEvents > 0U );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		uxCount = prvCollectReadyMembers( pxPollSet, pxEvents, uxMaxEvents );
+
+		if( ( uxCount != 0U ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Objects signal from interrupts too, so test the ready bitmap
+			and block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( pxPollSet->ulReady == 0UL )
+				{
+					traceBLOCKING_ON_POLL_SET_WAIT( pxPollSet );
+					vTaskPlaceOnEventList( &( pxPollSet->xTasksWaiting ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+
+			/* Timed out, take a last look. */
+			uxCount = prvCollectReadyMembers( pxPollSet, pxEvents, uxMaxEvents );
+			break;
+		}
+	}
+
+	tracePOLL_SET_WAIT( pxPollSet, uxCount );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetDelete( PollSetHandle_t xPollSet )
+{
+PollSet_t * const pxPollSet = xPollSet;
+
+	configASSERT( pxPollSet );
+	configASSERT( pxPollSet->ulMembers == 0UL );
+	configASSERT( listLIST_IS_EMPTY( &( pxPollSet->xTasksWaiting ) ) != pdFALSE );
+
+	tracePOLL_SET_DELETE( pxPollSet );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxPollSet );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxPollSet->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxPollSet );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPollSetSignal( PollMemberHandle_t xMember, const EventBits_t uxBits )
+{
+PollMember_t * const pxMember = xMember;
+PollSet_t * const pxPollSet = pxMember->pxPollSet;
+BaseType_t xReturn = pdFALSE;
+
+	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED. */
+	if( ( uxBits & pxMember->uxEvents ) != ( EventBits_t ) 0 )
+	{
+		pxPollSet->ulReady |= pollMEMBER_BIT( ( UBaseType_t ) ( pxMember - pxPollSet->xMembers ) );
+
+		if( listLIST_IS_EMPTY( &( pxPollSet->xTasksWaiting ) ) == pdFALSE )
+		{
+			xReturn = xTaskRemoveFromEventList( &( pxPollSet->xTasksWaiting ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewPollSet( PollSet_t *pxPollSet )
+{
+	pxPollSet->ulReady = 0UL;
+	pxPollSet->ulMembers = 0UL;
+	vListInitialise( &( pxPollSet->xTasksWaiting ) );
+	pxPollSet->uxNextMember = 0U;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetObjectMember( const PollMember_t * const pxMember, PollMemberHandle_t xMember )
+{
+BaseType_t xReturn;
+
+	switch( ( ePollObjectType ) pxMember->ucType )
+	{
+		case ePollQueue :
+			xReturn = xQueueSetPollMember( ( QueueHandle_t ) pxMember->pvObject, xMember );
+			break;
+
+		case ePollStreamBuffer :
+			xReturn = xStreamBufferSetPollMember( ( StreamBufferHandle_t ) pxMember->pvObject, xMember );
+			break;
+
+		case ePollEventGroup :
+			xReturn = xEventGroupSetPollMember( ( EventGroupHandle_t ) pxMember->pvObject, xMember );
+			break;
+
+		#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			case ePollTaskNotification :
+				xReturn = xTaskSetPollMember( ( TaskHandle_t ) pxMember->pvObject, xMember );
+				break;
+		#endif
+
+		default :
+			xReturn = pdFAIL;
+			break;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvObjectIsReady( const PollMember_t * const pxMember )
+{
+BaseType_t xReturn;
+
+	switch( ( ePollObjectType ) pxMember->ucType )
+	{
+		case ePollQueue :
+			xReturn = ( uxQueueMessagesWaiting( ( QueueHandle_t ) pxMember->pvObject ) != ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+			break;
+
+		case ePollStreamBuffer :
+			xReturn = ( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxMember->pvObject ) == pdFALSE ) ? pdTRUE : pdFALSE;
+			break;
+
+		case ePollEventGroup :
+			xReturn = ( ( xEventGroupGetBits( ( EventGroupHandle_t ) pxMember->pvObject ) & pxMember->uxEvents ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+			break;
+
+		#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			case ePollTaskNotification :
+				xReturn = xTaskNotifyStatePending( ( TaskHandle_t ) pxMember->pvObject );
+				break;
+		#endif
+
+		default :
+			xReturn = pdFALSE;
+			break;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCollectReadyMembers( PollSet_t * const pxPollSet, PollEvent_t * const pxEvents, const UBaseType_t uxMaxEvents )
+{
+uint32_t ulReady = pxPollSet->ulReady;
+UBaseType_t uxMember = pxPollSet->uxNextMember, uxScanned, uxCount = 0U;
+PollMember_t *pxMember;
+BaseType_t xReport;
+
+	for( uxScanned = 0U; ( uxScanned < ( UBaseType_t ) configPOLL_SET_MAX_MEMBERS ) && ( ulReady != 0UL ) && ( uxCount < uxMaxEvents ); uxScanned++ )
+	{
+		if( ( ulReady & pollMEMBER_BIT( uxMember ) ) != 0UL )
+		{
+			ulReady &= ~pollMEMBER_BIT( uxMember );
+			pxMember = &( pxPollSet->xMembers[ uxMember ] );
+
+			/* Clear the bit before looking at the object, so a write after
+			the look sets it again and is not lost. */
+			taskENTER_CRITICAL();
+			{
+				pxPollSet->ulReady &= ~pollMEMBER_BIT( uxMember );
+				xReport = ( ( pxPollSet->ulMembers & pollMEMBER_BIT( uxMember ) ) != 0UL ) ? pdTRUE : pdFALSE;
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xReport != pdFALSE ) && ( pxMember->ucEdgeTriggered == ( uint8_t ) pdFALSE ) )
+			{
+				/* A level triggered member is reported while its object is
+				ready, and stays in the bitmap until it is found not to be. */
+				xReport = prvObjectIsReady( pxMember );
+
+				if( xReport != pdFALSE )
+				{
+					taskENTER_CRITICAL();
+					{
+						pxPollSet->ulReady |= pollMEMBER_BIT( uxMember );
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xReport != pdFALSE )
+			{
+				pxEvents[ uxCount ].pvObject = pxMember->pvObject;
+				pxEvents[ uxCount ].pvUserData = pxMember->pvUserData;
+				pxEvents[ uxCount ].eType = ( ePollObjectType ) pxMember->ucType;
+				uxCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxMember++;
+
+		if( uxMember >= ( UBaseType_t ) configPOLL_SET_MAX_MEMBERS )
+		{
+			uxMember = 0U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* The next call starts after the last member looked at. */
+	pxPollSet->uxNextMember = uxMember;
+
+	return uxCount;
+}
+
+#endif /* configUSE_POLL_SETS */
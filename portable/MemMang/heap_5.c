@@ -112,6 +112,12 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList(BlockLink_t *pxBlockToInsert);
 
+/*
+ * Allocates a block of xWantedSize bytes, xWantedSize must not be 0.  Unlike
+ * pvPortMalloc() it does not call the malloc failed hook.
+ */
+static void *prvHeapMalloc(size_t xWantedSize);
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -154,27 +160,47 @@ static HeapRegion_t xDefRegion[MAX_REGION_CNT + 1] =
 
 /*-----------------------------------------------------------*/
 
+#ifdef CONFIG_HEAP_ALLOC_TRACE
+#include "aml_alloc_trace_ext.c"
+#else
+#define vPortAllocTraceRecord(ucType, pv, xSize, xAlignMsk)
+#endif
+
+#if defined(CONFIG_MEMORY_ERROR_DETECTION) || defined(CONFIG_HEAP_GUARDED_SAMPLING)
+#include "aml_calltrace_ext.c"
+#endif
+
 #ifdef CONFIG_MEMORY_ERROR_DETECTION
 #include "aml_med_ext.c"
 #endif
 
+#ifdef CONFIG_HEAP_GUARDED_SAMPLING
+#include "aml_gwp_ext.c"
+#endif
+
 #ifdef CONFIG_DMALLOC
 #include "aml_dmalloc_ext.c"
 #endif
 
-void *pvPortMalloc(size_t xWantedSize)
+#ifdef CONFIG_HEAP_PREFILL_POOL
+#include "aml_heap_5_ext.h"
+#endif
+
+static void *prvHeapMalloc(size_t xWantedSize)
 {
 	BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 	void *pvReturn = NULL;
 	unsigned long flags;
 
+#ifdef CONFIG_HEAP_ALLOC_TRACE
+	/* The trace records the size asked for, which a replay asks for again */
+	size_t xRequestedSize = xWantedSize;
+#endif
+
 #ifdef CONFIG_MEMORY_ERROR_DETECTION
 	size_t dMallocsz = xWantedSize;
 #endif
 
-	if (xWantedSize <= 0)
-		return pvReturn;
-
 #if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
 	portIRQ_SAVE(flags);
 #else
@@ -192,11 +218,17 @@ void *pvPortMalloc(size_t xWantedSize)
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+#ifdef CONFIG_HEAP_GUARDED_SAMPLING
+		/* A sampled request is served from the guarded pool, counting down to
+		the next sample under the same lock as the heap itself */
+		pvReturn = pvGuardedSampleMalloc(xWantedSize);
+#endif
+
 		/* Check the requested block size is not so large that the top bit is
 		set.  The top bit of the block size member of the BlockLink_t structure
 		is used to determine who owns the block - the application or the
 		kernel, so it must be free. */
-		if ((xWantedSize & xBlockAllocatedBit) == 0)
+		if ((pvReturn == NULL) && ((xWantedSize & xBlockAllocatedBit) == 0))
 		{
 			/* The wanted size is increased so it can contain a BlockLink_t
 			structure in addition to the requested amount of bytes. */
@@ -249,6 +281,9 @@ void *pvPortMalloc(size_t xWantedSize)
 					/* This block is being returned for use so must be taken out
 					of the list of free blocks. */
 					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+					vIntegrityCheckUnlink(pxBlock, pxPreviousBlock);
+#endif
 
 					/* If the block is larger than required it can be split into
 					two. */
@@ -316,6 +351,7 @@ void *pvPortMalloc(size_t xWantedSize)
 		}
 
 		traceMALLOC(pvReturn, xWantedSize);
+		vPortAllocTraceRecord(ALLOC_TRACE_MALLOC, pvReturn, xRequestedSize, 0);
 	}
 #if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
 	portIRQ_RESTORE(flags);
@@ -323,6 +359,25 @@ void *pvPortMalloc(size_t xWantedSize)
 	(void)xTaskResumeAll();
 #endif
 
+	return pvReturn;
+}
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+	void *pvReturn;
+
+	if (xWantedSize <= 0)
+		return NULL;
+
+	pvReturn = prvHeapMalloc(xWantedSize);
+
+#ifdef CONFIG_HEAP_PREFILL_POOL
+	/* The pre-filled blocks are free memory held back for later, give them
+	   back and try once more before failing */
+	if ((pvReturn == NULL) && (xPortPrefillPoolDrain() != 0))
+		pvReturn = prvHeapMalloc(xWantedSize);
+#endif
+
 #if (configUSE_MALLOC_FAILED_HOOK == 1)
 	{
 		if (pvReturn == NULL)
@@ -416,6 +471,11 @@ void *pvPortMallocRsvAlign(size_t xWantedSize, size_t xAlignMsk)
 	void *pvReturn = NULL;
 	unsigned long flags;
 
+#ifdef CONFIG_HEAP_ALLOC_TRACE
+	/* The trace records the size asked for, which a replay asks for again */
+	size_t xRequestedSize = xWantedSize;
+#endif
+
 	if (xWantedSize <= 0)
 		return pvReturn;
 	configASSERT(((xAlignMsk + 1) & xAlignMsk) == 0);
@@ -496,6 +556,9 @@ void *pvPortMallocRsvAlign(size_t xWantedSize, size_t xAlignMsk)
 					else
 					{
 						pxPreviousBlock->pxNextFreeBlock = pxTmp->pxNextFreeBlock;
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+						vIntegrityCheckUnlink(pxBlock, pxPreviousBlock);
+#endif
 					}
 					pxBlock = pxTmp;
 
@@ -554,6 +617,7 @@ void *pvPortMallocRsvAlign(size_t xWantedSize, size_t xAlignMsk)
 		}
 
 		traceMALLOC(pvReturn, xWantedSize);
+		vPortAllocTraceRecord(ALLOC_TRACE_MALLOC_RSV_ALIGN, pvReturn, xRequestedSize, xAlignMsk);
 	}
 
 #if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
@@ -571,6 +635,11 @@ void *pvPortMallocAlign(size_t xWantedSize, size_t xAlignMsk)
 	void *pvReturn = NULL;
 	unsigned long flags;
 
+#ifdef CONFIG_HEAP_ALLOC_TRACE
+	/* The trace records the size asked for, which a replay asks for again */
+	size_t xRequestedSize = xWantedSize;
+#endif
+
 #ifdef CONFIG_MEMORY_ERROR_DETECTION
 	size_t dMallocsz = xWantedSize;
 #endif
@@ -665,6 +734,9 @@ void *pvPortMallocAlign(size_t xWantedSize, size_t xAlignMsk)
 					{
 						configASSERT(pxTmp == pxBlock);
 						pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+						vIntegrityCheckUnlink(pxBlock, pxPreviousBlock);
+#endif
 					}
 
 					/* If the block is larger than required it can be split into
@@ -732,6 +804,7 @@ void *pvPortMallocAlign(size_t xWantedSize, size_t xAlignMsk)
 		}
 
 		traceMALLOC(pvReturn, xWantedSize);
+		vPortAllocTraceRecord(ALLOC_TRACE_MALLOC_ALIGN, pvReturn, xRequestedSize, xAlignMsk);
 	}
 #if defined(CONFIG_ARM64) || defined(CONFIG_ARM)
 	portIRQ_RESTORE(flags);
@@ -765,6 +838,14 @@ void vPortFree(void *pv)
 
 	if (pv != NULL)
 	{
+#ifdef CONFIG_HEAP_GUARDED_SAMPLING
+		if (xGuardedOwns(pv))
+		{
+			vGuardedFree(pv);
+			return;
+		}
+#endif
+
 		/* The memory being freed will have an BlockLink_t structure immediately
 		before it. */
 		puc -= xHeapStructSize;
@@ -798,6 +879,7 @@ void vPortFree(void *pv)
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE(pv, pxLink->xBlockSize);
+					vPortAllocTraceRecord(ALLOC_TRACE_FREE, pv, pxLink->xBlockSize, 0);
 #ifdef CONFIG_MEMORY_ERROR_DETECTION
 					vPortRmFromList((size_t)pxLink);
 #endif
@@ -876,6 +958,9 @@ static void prvInsertBlockIntoFreeList(BlockLink_t *pxBlockToInsert)
 		if (pxIterator->pxNextFreeBlock != pxEnd)
 		{
 			/* Form one big block from the two blocks. */
+#ifdef CONFIG_MEMORY_ERROR_DETECTION
+			vIntegrityCheckUnlink(pxIterator->pxNextFreeBlock, pxBlockToInsert);
+#endif
 			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
 			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
 		}
@@ -0,0 +1,700 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "priority_queue.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if( configUSE_PREEMPTION == 0 )
+	#define priorityqueueYIELD_IF_USING_PREEMPTION()
+#else
+	#define priorityqueueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* Each node of the storage area holds the index of the node behind it in the
+same list, followed by the item.  A node is either in the list of one priority
+or in the free list. */
+#define priorityqueueNO_NODE			( ~( UBaseType_t ) 0U )
+#define priorityqueueHEADER_SIZE		sizeof( UBaseType_t )
+#define priorityqueueNODE_SIZE( uxItemSize )	( ( priorityqueueHEADER_SIZE + ( size_t ) ( uxItemSize ) + sizeof( UBaseType_t ) - 1U ) & ~( sizeof( UBaseType_t ) - 1U ) )
+
+#define priorityqueueNODE( pxQueue, uxNode )	( &( ( pxQueue )->pucStorage[ ( size_t ) ( uxNode ) * ( pxQueue )->xNodeSize ] ) )
+#define priorityqueueNEXT( pucNode )			( *( ( UBaseType_t * ) ( pucNode ) ) ) /*lint !e9087 !e826 Nodes are aligned for a UBaseType_t. */
+
+/* The highest priority that has items, found as the scheduler finds the
+highest priority ready task. */
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#define priorityqueueHIGHEST_PRIORITY( uxPriority, uxReadyPriorities )	portGET_HIGHEST_PRIORITY( ( uxPriority ), ( uxReadyPriorities ) )
+
+#else
+
+	#define priorityqueueHIGHEST_PRIORITY( uxPriority, uxReadyPriorities )					\
+	{																						\
+		( uxPriority ) = ( UBaseType_t ) configPRIORITY_QUEUE_LEVELS - 1U;					\
+		while( ( ( uxReadyPriorities ) & ( ( UBaseType_t ) 1U << ( uxPriority ) ) ) == 0U )	\
+		{																					\
+			--( uxPriority );																\
+		}																					\
+	}
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+typedef struct PriorityQueueDef_t
+{
+	uint8_t *pucStorage;				/*< The nodes. */
+	size_t xNodeSize;					/*< The size of a node, the item plus the index of the next node, rounded up. */
+	UBaseType_t uxLength;				/*< The number of nodes. */
+	UBaseType_t uxItemSize;				/*< The size of each item. */
+	volatile UBaseType_t uxMessagesWaiting;	/*< The number of items in the queue. */
+	UBaseType_t uxFreeNode;				/*< The first node of the free list, priorityqueueNO_NODE if the queue is full. */
+	UBaseType_t uxReadyPriorities;		/*< Bit n is set while there are items of priority n. */
+	UBaseType_t uxHead[ configPRIORITY_QUEUE_LEVELS ];	/*< The oldest item of each priority. */
+	UBaseType_t uxTail[ configPRIORITY_QUEUE_LEVELS ];	/*< The newest item of each priority. */
+	List_t xTasksWaitingToSend;			/*< Tasks blocked waiting for space, in priority order. */
+	List_t xTasksWaitingToReceive;		/*< Tasks blocked waiting for an item, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the queue is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} PriorityQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a queue that has been allocated.
+ */
+static void prvInitialisePriorityQueue( PriorityQueue_t * const pxQueue, const UBaseType_t uxLength, const UBaseType_t uxItemSize, uint8_t * const pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy an item into a free node at the back of the list of its priority, then
+ * unblock the highest priority task waiting to receive.  Returns pdFAIL if the
+ * queue is full.  *pxYieldRequired is set to pdTRUE if the task unblocked has
+ * a priority above the calling task.  Called with interrupts masked.
+ */
+static BaseType_t prvPriorityQueueWrite( PriorityQueue_t * const pxQueue, const void * const pvItemToQueue, const UBaseType_t uxPriority, BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy out and free the oldest item of the highest priority, then unblock the
+ * highest priority task waiting to send.  Returns pdFAIL if the queue is
+ * empty.  *pxYieldRequired is set as by prvPriorityQueueWrite().  Called with
+ * interrupts masked.
+ */
+static BaseType_t prvPriorityQueueRead( PriorityQueue_t * const pxQueue, void * const pvBuffer, UBaseType_t * const puxPriority, BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorageBuffer, StaticPriorityQueue_t *pxPriorityQueueBuffer )
+	{
+	PriorityQueue_t *pxQueue;
+
+		configASSERT( pxPriorityQueueBuffer );
+		configASSERT( pucQueueStorageBuffer );
+		configASSERT( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorageBuffer & ( sizeof( UBaseType_t ) - 1U ) ) == 0U );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticPriorityQueue_t equals the size of the real
+			queue structure. */
+			volatile size_t xSize = sizeof( StaticPriorityQueue_t );
+			configASSERT( xSize == sizeof( PriorityQueue_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxQueue = ( PriorityQueue_t * ) pxPriorityQueueBuffer; /*lint !e740 !e9087 PriorityQueue_t and StaticPriorityQueue_t are deliberately aliased for data hiding purposes. */
+
+		if( pxQueue != NULL )
+		{
+			prvInitialisePriorityQueue( pxQueue, uxLength, uxItemSize, pucQueueStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			tracePRIORITY_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_CREATE_FAILED();
+		}
+
+		return pxQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize )
+	{
+	PriorityQueue_t *pxQueue;
+
+		/* The storage area follows the structure, which pvPortMalloc() aligns
+		for any type and which is a multiple of the size of a UBaseType_t
+		long. */
+		pxQueue = ( PriorityQueue_t * ) pvPortMalloc( sizeof( PriorityQueue_t ) + priorityqueueSTORAGE_SIZE( uxLength, uxItemSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxQueue != NULL )
+		{
+			prvInitialisePriorityQueue( pxQueue, uxLength, uxItemSize, ( ( uint8_t * ) pxQueue ) + sizeof( PriorityQueue_t ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			tracePRIORITY_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxQueue;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialisePriorityQueue( PriorityQueue_t * const pxQueue, const UBaseType_t uxLength, const UBaseType_t uxItemSize, uint8_t * const pucStorage )
+{
+UBaseType_t uxNode, uxPriority;
+
+	configASSERT( uxLength != 0U );
+	configASSERT( uxItemSize != 0U );
+
+	pxQueue->pucStorage = pucStorage;
+	pxQueue->xNodeSize = priorityqueueNODE_SIZE( uxItemSize );
+	pxQueue->uxLength = uxLength;
+	pxQueue->uxItemSize = uxItemSize;
+	pxQueue->uxMessagesWaiting = 0U;
+	pxQueue->uxReadyPriorities = 0U;
+
+	/* Chain every node into the free list. */
+	pxQueue->uxFreeNode = 0U;
+
+	for( uxNode = 0U; uxNode < uxLength; uxNode++ )
+	{
+		priorityqueueNEXT( priorityqueueNODE( pxQueue, uxNode ) ) = ( ( uxNode + 1U ) < uxLength ) ? ( uxNode + 1U ) : priorityqueueNO_NODE;
+	}
+
+	for( uxPriority = 0U; uxPriority < ( UBaseType_t ) configPRIORITY_QUEUE_LEVELS; uxPriority++ )
+	{
+		pxQueue->uxHead[ uxPriority ] = priorityqueueNO_NODE;
+		pxQueue->uxTail[ uxPriority ] = priorityqueueNO_NODE;
+	}
+
+	vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+	vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, TickType_t xTicksToWait )
+{
+PriorityQueue_t * const pxQueue = xQueue;
+BaseType_t xReturn, xEntryTimeSet = pdFALSE, xYieldRequired, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemToQueue );
+	configASSERT( uxPriority < ( UBaseType_t ) configPRIORITY_QUEUE_LEVELS );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvPriorityQueueWrite( pxQueue, pvItemToQueue, uxPriority, &xYieldRequired );
+
+			if( xYieldRequired != pdFALSE )
+			{
+				priorityqueueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xReturn == pdPASS ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Items are received from interrupts too, so test for space and
+			block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( pxQueue->uxFreeNode == priorityqueueNO_NODE )
+				{
+					traceBLOCKING_ON_PRIORITY_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+
+			/* Timed out, make a last attempt. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvPriorityQueueWrite( pxQueue, pvItemToQueue, uxPriority, &xYieldRequired );
+
+				if( xYieldRequired != pdFALSE )
+				{
+					priorityqueueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	if( xReturn == pdPASS )
+	{
+		tracePRIORITY_QUEUE_SEND( pxQueue, uxPriority );
+	}
+	else
+	{
+		tracePRIORITY_QUEUE_SEND_FAILED( pxQueue );
+		xReturn = errQUEUE_FULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void * const pvItemToQueue, UBaseType_t uxPriority, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+PriorityQueue_t * const pxQueue = xQueue;
+BaseType_t xReturn, xYieldRequired = pdFALSE;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemToQueue );
+	configASSERT( uxPriority < ( UBaseType_t ) configPRIORITY_QUEUE_LEVELS );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xReturn = prvPriorityQueueWrite( pxQueue, pvItemToQueue, uxPriority, &xYieldRequired );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		tracePRIORITY_QUEUE_SEND_FROM_ISR( pxQueue, uxPriority );
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		xReturn = errQUEUE_FULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, TickType_t xTicksToWait )
+{
+PriorityQueue_t * const pxQueue = xQueue;
+BaseType_t xReturn, xEntryTimeSet = pdFALSE, xYieldRequired, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvPriorityQueueRead( pxQueue, pvBuffer, puxPriority, &xYieldRequired );
+
+			if( xYieldRequired != pdFALSE )
+			{
+				priorityqueueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xReturn == pdPASS ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Items are sent from interrupts too, so test for an item and
+			block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( pxQueue->uxMessagesWaiting == 0U )
+				{
+					traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+
+			/* Timed out, make a last attempt. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvPriorityQueueRead( pxQueue, pvBuffer, puxPriority, &xYieldRequired );
+
+				if( xYieldRequired != pdFALSE )
+				{
+					priorityqueueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	if( xReturn == pdPASS )
+	{
+		tracePRIORITY_QUEUE_RECEIVE( pxQueue );
+	}
+	else
+	{
+		tracePRIORITY_QUEUE_RECEIVE_FAILED( pxQueue );
+		xReturn = errQUEUE_EMPTY;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void * const pvBuffer, UBaseType_t * const puxPriority, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+PriorityQueue_t * const pxQueue = xQueue;
+BaseType_t xReturn, xYieldRequired = pdFALSE;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xReturn = prvPriorityQueueRead( pxQueue, pvBuffer, puxPriority, &xYieldRequired );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		tracePRIORITY_QUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		xReturn = errQUEUE_EMPTY;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue )
+{
+const PriorityQueue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	return pxQueue->uxMessagesWaiting;
+}
+/*-----------------------------------------------------------*/
+
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue )
+{
+PriorityQueue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	tracePRIORITY_QUEUE_DELETE( pxQueue );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPriorityQueueWrite( PriorityQueue_t * const pxQueue, const void * const pvItemToQueue, const UBaseType_t uxPriority, BaseType_t * const pxYieldRequired )
+{
+UBaseType_t const uxNode = pxQueue->uxFreeNode;
+uint8_t *pucNode;
+BaseType_t xReturn;
+
+	if( uxNode != priorityqueueNO_NODE )
+	{
+		pucNode = priorityqueueNODE( pxQueue, uxNode );
+		pxQueue->uxFreeNode = priorityqueueNEXT( pucNode );
+
+		( void ) memcpy( ( void * ) &( pucNode[ priorityqueueHEADER_SIZE ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		priorityqueueNEXT( pucNode ) = priorityqueueNO_NODE;
+
+		/* Append to the list of the priority. */
+		if( ( pxQueue->uxReadyPriorities & ( ( UBaseType_t ) 1U << uxPriority ) ) != 0U )
+		{
+			priorityqueueNEXT( priorityqueueNODE( pxQueue, pxQueue->uxTail[ uxPriority ] ) ) = uxNode;
+		}
+		else
+		{
+			pxQueue->uxHead[ uxPriority ] = uxNode;
+			pxQueue->uxReadyPriorities |= ( UBaseType_t ) 1U << uxPriority;
+		}
+
+		pxQueue->uxTail[ uxPriority ] = uxNode;
+		( pxQueue->uxMessagesWaiting )++;
+
+		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+			{
+				*pxYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPriorityQueueRead( PriorityQueue_t * const pxQueue, void * const pvBuffer, UBaseType_t * const puxPriority, BaseType_t * const pxYieldRequired )
+{
+UBaseType_t uxPriority, uxNode;
+uint8_t *pucNode;
+BaseType_t xReturn;
+
+	if( pxQueue->uxReadyPriorities != 0U )
+	{
+		priorityqueueHIGHEST_PRIORITY( uxPriority, pxQueue->uxReadyPriorities );
+
+		/* Unlink the oldest item of the priority. */
+		uxNode = pxQueue->uxHead[ uxPriority ];
+		pucNode = priorityqueueNODE( pxQueue, uxNode );
+		pxQueue->uxHead[ uxPriority ] = priorityqueueNEXT( pucNode );
+
+		if( pxQueue->uxHead[ uxPriority ] == priorityqueueNO_NODE )
+		{
+			pxQueue->uxReadyPriorities &= ~( ( UBaseType_t ) 1U << uxPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) memcpy( pvBuffer, ( void * ) &( pucNode[ priorityqueueHEADER_SIZE ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+		if( puxPriority != NULL )
+		{
+			*puxPriority = uxPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Return the node to the free list. */
+		priorityqueueNEXT( pucNode ) = pxQueue->uxFreeNode;
+		pxQueue->uxFreeNode = uxNode;
+		( pxQueue->uxMessagesWaiting )--;
+
+		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+			{
+				*pxYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
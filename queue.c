@@ -37,6 +37,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
 #endif
@@ -128,6 +132,18 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_MUTEX_CEILING == 1 )
+		UBaseType_t uxCeilingPriority;	/*< The priority a task runs at while it holds the mutex, tskIDLE_PRIORITY if the mutex uses priority inheritance only. */
+	#endif
+
+	#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+		ListItem_t xMutexHeldListItem;	/*< Used to reference the mutex from the list of mutexes held by its holder. */
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		PollMemberHandle_t xPollMember;	/*< The poll set member the queue is, or NULL. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -198,6 +214,18 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_HANDOFF == 1 )
+	/*
+	 * If the queue is empty and the task that would be unblocked by the item
+	 * is blocked in xQueueReceive(), copy the item straight into the task's
+	 * receive buffer and unblock the task.  Returns pdTRUE if the item was
+	 * handed off, in which case *pxYieldRequired is set as
+	 * xTaskRemoveFromEventList() would return.  Must be called with interrupts
+	 * masked and the queue unlocked.
+	 */
+	static BaseType_t prvHandoffToReceiver( Queue_t * const pxQueue, const void *pvItemToQueue, BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -464,6 +492,18 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_MUTEX_CEILING == 1 )
+	{
+		pxNewQueue->uxCeilingPriority = tskIDLE_PRIORITY;
+	}
+	#endif /* configUSE_MUTEX_CEILING */
+
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		pxNewQueue->xPollMember = NULL;
+	}
+	#endif /* configUSE_POLL_SETS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -484,6 +524,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+			{
+				vListInitialiseItem( &( pxNewQueue->xMutexHeldListItem ) );
+				listSET_LIST_ITEM_OWNER( &( pxNewQueue->xMutexHeldListItem ), pxNewQueue );
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -534,7 +581,59 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		/* The mutex is not held yet, so the ceiling can be set after it has
+		been created. */
+		xNewQueue = xQueueCreateMutex( ucQueueType );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MUTEX_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		xNewQueue = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) || ( configUSE_TRANSITIVE_INHERITANCE == 1 ) ) )
 
 	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
 	{
@@ -767,6 +866,26 @@ Queue_t * const pxQueue = xQueue;
 	{
 		taskENTER_CRITICAL();
 		{
+			#if ( configUSE_QUEUE_HANDOFF == 1 )
+			if( prvHandoffToReceiver( pxQueue, pvItemToQueue, &xYieldRequired ) != pdFALSE )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				if( xYieldRequired != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else
+			#endif /* configUSE_QUEUE_HANDOFF */
+
 			/* Is there room on the queue now?  The running task must be the
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
@@ -871,6 +990,26 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_QUEUE_SETS */
 
+				#if ( configUSE_POLL_SETS == 1 )
+				{
+					if( pxQueue->xPollMember != NULL )
+					{
+						if( xPollSetSignal( pxQueue->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE )
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_POLL_SETS */
+
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -987,6 +1126,28 @@ Queue_t * const pxQueue = xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
+		#if ( configUSE_QUEUE_HANDOFF == 1 )
+		BaseType_t xYieldRequired;
+
+		/* The event list cannot be altered while the queue is locked. */
+		if( ( pxQueue->cTxLock == queueUNLOCKED ) && ( prvHandoffToReceiver( pxQueue, pvItemToQueue, &xYieldRequired ) != pdFALSE ) )
+		{
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+			if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		#endif /* configUSE_QUEUE_HANDOFF */
+
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
@@ -1091,6 +1252,33 @@ Queue_t * const pxQueue = xQueue;
 				pxQueue->cTxLock = ( int8_t ) ( cTxLock + 1 );
 			}
 
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				if( pxQueue->xPollMember != NULL )
+				{
+					if( xPollSetSignal( pxQueue->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			xReturn = pdPASS;
 		}
 		else
@@ -1256,6 +1444,33 @@ Queue_t * const pxQueue = xQueue;
 				pxQueue->cTxLock = ( int8_t ) ( cTxLock + 1 );
 			}
 
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				if( pxQueue->xPollMember != NULL )
+				{
+					if( xPollSetSignal( pxQueue->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
+
 			xReturn = pdPASS;
 		}
 		else
@@ -1371,6 +1586,14 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+				#if ( configUSE_QUEUE_HANDOFF == 1 )
+				{
+					/* Let a sender copy the item straight to pvBuffer. */
+					vTaskSetHandoffBuffer( pvBuffer );
+				}
+				#endif
+
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1381,6 +1604,23 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				#if ( configUSE_QUEUE_HANDOFF == 1 )
+				{
+					if( xTaskHandoffCompleted() != pdFALSE )
+					{
+						/* The item is in pvBuffer already, and the queue storage
+						area was never used so no sender can be waiting for
+						space it freed. */
+						traceQUEUE_RECEIVE( pxQueue );
+						return pdPASS;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_QUEUE_HANDOFF */
 			}
 			else
 			{
@@ -1463,7 +1703,32 @@ Queue_t * const pxQueue = xQueue;
 					{
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
-						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+						{
+							pxQueue->u.xSemaphore.xMutexHolder = pvTaskMutexTaken( &( pxQueue->xMutexHeldListItem ) );
+						}
+						#else
+						{
+							pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						}
+						#endif
+
+						#if ( configUSE_MUTEX_CEILING == 1 )
+						{
+							/* Run at the ceiling straight away, so no task
+							that can contend for the mutex preempts the
+							holder.  The priority is restored by the
+							disinheritance on give. */
+							if( pxQueue->uxCeilingPriority > tskIDLE_PRIORITY )
+							{
+								vTaskPriorityCeilingRaise( pxQueue->uxCeilingPriority );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_MUTEX_CEILING */
 					}
 					else
 					{
@@ -1551,7 +1816,18 @@ Queue_t * const pxQueue = xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
-							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+							#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+							{
+								/* The inheritance is recomputed on timeout
+								whether or not it raised a task. */
+								vTaskMutexInherit( pxQueue, pxQueue->u.xSemaphore.xMutexHolder );
+								xInheritanceOccurred = pdTRUE;
+							}
+							#else
+							{
+								xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1602,15 +1878,25 @@ Queue_t * const pxQueue = xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
-							UBaseType_t uxHighestWaitingPriority;
-
-							/* This task blocking on the mutex caused another
-							task to inherit this task's priority.  Now this task
-							has timed out the priority should be disinherited
-							again, but only as low as the next highest priority
-							task that is waiting for the same mutex. */
-							uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-							vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+							#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+							{
+								/* Recompute the priorities along the chain of
+								holders this task was waiting behind. */
+								vTaskMutexDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder );
+							}
+							#else
+							{
+								UBaseType_t uxHighestWaitingPriority;
+
+								/* This task blocking on the mutex caused another
+								task to inherit this task's priority.  Now this task
+								has timed out the priority should be disinherited
+								again, but only as low as the next highest priority
+								task that is waiting for the same mutex. */
+								uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+								vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -2061,12 +2347,39 @@ Queue_t * const pxQueue = xQueue;
 			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
 		}
 
+		#if ( configUSE_MUTEX_CEILING == 1 )
+		{
+			/* The holder never drops below the ceiling while it holds the
+			mutex. */
+			if( uxHighestPriorityOfWaitingTasks < pxQueue->uxCeilingPriority )
+			{
+				uxHighestPriorityOfWaitingTasks = pxQueue->uxCeilingPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		return uxHighestPriorityOfWaitingTasks;
 	}
 
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+	UBaseType_t uxQueueGetMutexWaitingPriority( QueueHandle_t xMutex )
+	{
+		/* Called from a critical section by the kernel when it recomputes the
+		priority of the mutex holder. */
+		return prvGetDisinheritPriorityAfterTimeout( ( Queue_t * ) xMutex );
+	}
+
+#endif /* configUSE_TRANSITIVE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
@@ -2083,7 +2396,26 @@ UBaseType_t uxMessagesWaiting;
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
 				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+				{
+					/* The mutex is not in a list when it is first given
+					during creation. */
+					if( listLIST_ITEM_CONTAINER( &( pxQueue->xMutexHeldListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxQueue->xMutexHeldListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xReturn = xTaskMutexDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				}
+				#else
+				{
+					xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				}
+				#endif
 				pxQueue->u.xSemaphore.xMutexHolder = NULL;
 			}
 			else
@@ -2164,6 +2496,48 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_HANDOFF == 1 )
+
+	static BaseType_t prvHandoffToReceiver( Queue_t * const pxQueue, const void *pvItemToQueue, BaseType_t * const pxYieldRequired )
+	{
+	BaseType_t xReturn = pdFALSE;
+	void *pvBuffer;
+
+		/* Only an item that would be the next one received can skip the
+		storage area.  Semaphores have no item to copy, and a queue in a queue
+		set must hold its items for the set to be read. */
+		if( ( pxQueue->uxItemSize != ( UBaseType_t ) 0 ) && ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+		{
+			#if ( configUSE_QUEUE_SETS == 1 )
+			if( pxQueue->pxQueueSetContainer == NULL )
+			#endif
+			{
+				/* NULL if the task is peeking rather than receiving. */
+				pvBuffer = pvTaskTakeHandoffBuffer( &( pxQueue->xTasksWaitingToReceive ) );
+
+				if( pvBuffer != NULL )
+				{
+					( void ) memcpy( pvBuffer, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+					*pxYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_HANDOFF */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2764,6 +3138,87 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+	void vQueueMoveToMutexRestricted( QueueHandle_t xMutex, List_t * const pxEventList, const BaseType_t xMoveAll )
+	{
+	Queue_t * const pxMutex = xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		designed for use by kernel code, and has special calling requirements -
+		it should be called with the scheduler suspended, and pxEventList must
+		only be accessed by tasks. */
+
+		prvLockQueue( pxMutex );
+		{
+			/* Each time the mutex is given the highest priority task waiting
+			for it is unblocked, so the moved tasks run one at a time, each
+			holding the mutex. */
+			while( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+			{
+				vTaskMoveToMutexEventList( pxEventList, ( void * ) pxMutex, &( pxMutex->xTasksWaitingToReceive ), pxMutex->u.xSemaphore.xMutexHolder );
+
+				if( xMoveAll == pdFALSE )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Nothing is going to give a mutex that is not held, so unblock a
+			task to take it, as giving the mutex would have. */
+			if( ( pxMutex->uxMessagesWaiting != ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToReceive ) ) == pdFALSE ) )
+			{
+				taskENTER_CRITICAL();
+				{
+					( void ) xTaskRemoveFromEventList( &( pxMutex->xTasksWaitingToReceive ) );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		prvUnlockQueue( pxMutex );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vQueueDisinheritAfterTimeoutRestricted( QueueHandle_t xMutex )
+	{
+	Queue_t * const pxMutex = xMutex;
+
+		configASSERT( pxMutex );
+
+		/* Called by a task that vQueueMoveToMutexRestricted() moved to wait
+		for the mutex, once its block time has expired.  It is no longer on
+		the event list of the mutex, so the holder stops inheriting from it,
+		as in xQueueSemaphoreTake() when a wait for a mutex times out. */
+		taskENTER_CRITICAL();
+		{
+			#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+			{
+				vTaskMutexDisinheritAfterTimeout( pxMutex->u.xSemaphore.xMutexHolder );
+			}
+			#else
+			{
+				vTaskPriorityDisinheritAfterTimeout( pxMutex->u.xSemaphore.xMutexHolder, prvGetDisinheritPriorityAfterTimeout( pxMutex ) );
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 	QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
@@ -2939,3 +3394,33 @@ Queue_t * const pxQueue = xQueue;
 
 
 
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xQueueSetPollMember( QueueHandle_t xQueue, PollMemberHandle_t xMember )
+	{
+	Queue_t * const pxQueue = xQueue;
+	BaseType_t xReturn;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( xMember != NULL ) && ( pxQueue->xPollMember != NULL ) )
+			{
+				/* Cannot add a queue/semaphore to more than one poll set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxQueue->xPollMember = xMember;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
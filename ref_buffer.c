@@ -0,0 +1,782 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "atomic.h"
+#include "ref_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if( configUSE_PREEMPTION == 0 )
+	#define refbufferYIELD_IF_USING_PREEMPTION()
+#else
+	#define refbufferYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* The data of a buffer follows its header, refbufferHEADER_SIZE bytes from the
+start of the block. */
+#define refbufferDATA( pxBuffer )	( ( void * ) ( ( ( uint8_t * ) ( pxBuffer ) ) + refbufferHEADER_SIZE ) )
+
+struct RefBufferPoolDef_t;
+
+typedef struct RefBufferDef_t
+{
+	struct RefBufferPoolDef_t *pxPool;	/*< The pool the buffer belongs to, NULL if it was allocated with pvPortMalloc(). */
+	struct RefBufferDef_t *pxNextFree;	/*< The next buffer in the free list of the pool, while the buffer is free. */
+	volatile uint32_t ulReferences;		/*< The number of references, only changed with atomic operations. */
+	size_t xSize;						/*< The size of the data. */
+} RefBuffer_t;
+
+typedef struct RefBufferPoolDef_t
+{
+	RefBuffer_t *pxFreeBuffers;			/*< The buffers not in use, NULL if all are in use. */
+	uint8_t *pucStorage;				/*< The blocks of the buffers. */
+	UBaseType_t uxBuffers;				/*< The number of buffers. */
+	UBaseType_t uxFreeBuffers;			/*< The number of buffers in pxFreeBuffers. */
+	size_t xBufferSize;					/*< The size of the data of each buffer. */
+	List_t xTasksWaiting;				/*< Tasks blocked in xRefBufferAlloc(), in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the pool is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} RefBufferPool_t;
+
+/* The storage area of a pool created by xRefBufferPoolCreate() follows the
+pool structure, aligned as the data of the buffers. */
+#define refbufferPOOL_SIZE			( ( sizeof( RefBufferPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	/* Buffers allocated with pvPortMalloc() whose last reference was released
+	from an interrupt that could not pass them to the timer task, linked
+	through pxNextFree.  Freed by the next release from a task. */
+	PRIVILEGED_DATA static RefBuffer_t * volatile pxDeferredFreeBuffers = NULL;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a pool that has been allocated, putting every buffer on the free
+ * list.
+ */
+static void prvInitialisePool( RefBufferPool_t * const pxPool, const UBaseType_t uxBuffers, const size_t xBufferSize, uint8_t * const pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take a buffer off the free list of a pool.  Returns NULL if the list is
+ * empty.  Called with interrupts masked.
+ */
+static RefBuffer_t *prvTakeFreeBuffer( RefBufferPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Put a buffer back on the free list of its pool and unblock the highest
+ * priority task waiting for one.  Returns pdTRUE if that task has a priority
+ * above the calling task.  Called with interrupts masked.
+ */
+static BaseType_t prvReturnBuffer( RefBuffer_t * const pxBuffer ) PRIVILEGED_FUNCTION;
+
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) )
+
+	/*
+	 * Frees a buffer allocated with pvPortMalloc() whose last reference was
+	 * released from an interrupt.  Runs in the timer task.
+	 */
+	static void prvFreeHeapBuffer( void *pvBuffer, uint32_t ulUnused ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	/*
+	 * Free the buffers on pxDeferredFreeBuffers.  Called from a task.
+	 */
+	static void prvFreeDeferredBuffers( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RefBufferPoolHandle_t xRefBufferPoolCreateStatic( UBaseType_t uxBuffers, size_t xBufferSize, uint8_t *pucPoolStorageBuffer, StaticRefBufferPool_t *pxPoolBuffer )
+	{
+	RefBufferPool_t *pxPool;
+
+		configASSERT( pxPoolBuffer );
+		configASSERT( pucPoolStorageBuffer );
+		configASSERT( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorageBuffer & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0U );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structures used to declare
+			variables of type StaticRefBufferPool_t and StaticRefBuffer_t equal
+			the size of the real structures. */
+			volatile size_t xSize = sizeof( StaticRefBufferPool_t );
+			configASSERT( xSize == sizeof( RefBufferPool_t ) );
+			xSize = sizeof( StaticRefBuffer_t );
+			configASSERT( xSize == sizeof( RefBuffer_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxPool = ( RefBufferPool_t * ) pxPoolBuffer; /*lint !e740 !e9087 RefBufferPool_t and StaticRefBufferPool_t are deliberately aliased for data hiding purposes. */
+
+		if( pxPool != NULL )
+		{
+			prvInitialisePool( pxPool, uxBuffers, xBufferSize, pucPoolStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxPool->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceREF_BUFFER_POOL_CREATE( pxPool );
+		}
+		else
+		{
+			traceREF_BUFFER_POOL_CREATE_FAILED();
+		}
+
+		return pxPool;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RefBufferPoolHandle_t xRefBufferPoolCreate( UBaseType_t uxBuffers, size_t xBufferSize )
+	{
+	RefBufferPool_t *pxPool;
+
+		pxPool = ( RefBufferPool_t * ) pvPortMalloc( refbufferPOOL_SIZE + refbufferPOOL_STORAGE_SIZE( uxBuffers, xBufferSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxPool != NULL )
+		{
+			prvInitialisePool( pxPool, uxBuffers, xBufferSize, ( ( uint8_t * ) pxPool ) + refbufferPOOL_SIZE );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxPool->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceREF_BUFFER_POOL_CREATE( pxPool );
+		}
+		else
+		{
+			traceREF_BUFFER_POOL_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialisePool( RefBufferPool_t * const pxPool, const UBaseType_t uxBuffers, const size_t xBufferSize, uint8_t * const pucStorage )
+{
+RefBuffer_t *pxBuffer;
+UBaseType_t uxBuffer;
+
+	configASSERT( uxBuffers != 0U );
+	configASSERT( xBufferSize != ( size_t ) 0 );
+
+	pxPool->pxFreeBuffers = NULL;
+	pxPool->pucStorage = pucStorage;
+	pxPool->uxBuffers = uxBuffers;
+	pxPool->uxFreeBuffers = uxBuffers;
+	pxPool->xBufferSize = xBufferSize;
+	vListInitialise( &( pxPool->xTasksWaiting ) );
+
+	/* Chain the blocks from the last, so buffers are handed out in order. */
+	for( uxBuffer = uxBuffers; uxBuffer > 0U; uxBuffer-- )
+	{
+		pxBuffer = ( RefBuffer_t * ) &( pucStorage[ ( size_t ) ( uxBuffer - 1U ) * refbufferBLOCK_SIZE( xBufferSize ) ] ); /*lint !e9087 !e826 Blocks are aligned to portBYTE_ALIGNMENT. */
+		pxBuffer->pxPool = pxPool;
+		pxBuffer->pxNextFree = pxPool->pxFreeBuffers;
+		pxBuffer->ulReferences = 0U;
+		pxBuffer->xSize = xBufferSize;
+		pxPool->pxFreeBuffers = pxBuffer;
+	}
+}
+/*-----------------------------------------------------------*/
+
+RefBufferHandle_t xRefBufferAlloc( RefBufferPoolHandle_t xPool, TickType_t xTicksToWait )
+{
+RefBufferPool_t * const pxPool = xPool;
+RefBuffer_t *pxBuffer;
+BaseType_t xEntryTimeSet = pdFALSE, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxPool );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxBuffer = prvTakeFreeBuffer( pxPool );
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( pxBuffer != NULL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Buffers are released from interrupts too, so test the free list
+			and block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( pxPool->pxFreeBuffers == NULL )
+				{
+					traceBLOCKING_ON_REF_BUFFER_ALLOC( pxPool );
+					vTaskPlaceOnEventList( &( pxPool->xTasksWaiting ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+
+			/* Timed out, take a last look. */
+			taskENTER_CRITICAL();
+			{
+				pxBuffer = prvTakeFreeBuffer( pxPool );
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	if( pxBuffer != NULL )
+	{
+		traceREF_BUFFER_ALLOC( pxBuffer );
+	}
+	else
+	{
+		traceREF_BUFFER_ALLOC_FAILED( pxPool );
+	}
+
+	return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+RefBufferHandle_t xRefBufferAllocFromISR( RefBufferPoolHandle_t xPool )
+{
+RefBufferPool_t * const pxPool = xPool;
+RefBuffer_t *pxBuffer;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxBuffer = prvTakeFreeBuffer( pxPool );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( pxBuffer != NULL )
+	{
+		traceREF_BUFFER_ALLOC( pxBuffer );
+	}
+	else
+	{
+		traceREF_BUFFER_ALLOC_FAILED( pxPool );
+	}
+
+	return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RefBufferHandle_t xRefBufferAllocFromHeap( size_t xBufferSize )
+	{
+	RefBuffer_t *pxBuffer;
+
+		configASSERT( xBufferSize != ( size_t ) 0 );
+
+		prvFreeDeferredBuffers();
+
+		pxBuffer = ( RefBuffer_t * ) pvPortMalloc( refbufferBLOCK_SIZE( xBufferSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxBuffer != NULL )
+		{
+			pxBuffer->pxPool = NULL;
+			pxBuffer->pxNextFree = NULL;
+			pxBuffer->ulReferences = 1U;
+			pxBuffer->xSize = xBufferSize;
+
+			traceREF_BUFFER_ALLOC( pxBuffer );
+		}
+		else
+		{
+			traceREF_BUFFER_ALLOC_FAILED( NULL );
+		}
+
+		return pxBuffer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void *pvRefBufferGetData( RefBufferHandle_t xBuffer )
+{
+RefBuffer_t * const pxBuffer = xBuffer;
+
+	configASSERT( pxBuffer );
+
+	return refbufferDATA( pxBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xRefBufferGetSize( RefBufferHandle_t xBuffer )
+{
+const RefBuffer_t * const pxBuffer = xBuffer;
+
+	configASSERT( pxBuffer );
+
+	return pxBuffer->xSize;
+}
+/*-----------------------------------------------------------*/
+
+void vRefBufferRetain( RefBufferHandle_t xBuffer )
+{
+RefBuffer_t * const pxBuffer = xBuffer;
+uint32_t ulReferences;
+
+	configASSERT( pxBuffer );
+
+	ulReferences = Atomic_Increment_u32( &( pxBuffer->ulReferences ) );
+
+	/* The caller must hold a reference already. */
+	configASSERT( ulReferences != 0U );
+	( void ) ulReferences;
+}
+/*-----------------------------------------------------------*/
+
+void vRefBufferRelease( RefBufferHandle_t xBuffer )
+{
+RefBuffer_t * const pxBuffer = xBuffer;
+uint32_t ulReferences;
+
+	configASSERT( pxBuffer );
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		prvFreeDeferredBuffers();
+	}
+	#endif
+
+	ulReferences = Atomic_Decrement_u32( &( pxBuffer->ulReferences ) );
+	configASSERT( ulReferences != 0U );
+
+	if( ulReferences == 1U )
+	{
+		/* That was the last reference. */
+		traceREF_BUFFER_FREE( pxBuffer );
+
+		if( pxBuffer->pxPool != NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( prvReturnBuffer( pxBuffer ) != pdFALSE )
+				{
+					refbufferYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				vPortFree( pxBuffer );
+			}
+			#endif
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vRefBufferReleaseFromISR( RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+RefBuffer_t * const pxBuffer = xBuffer;
+uint32_t ulReferences;
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xYieldRequired = pdFALSE;
+
+	configASSERT( pxBuffer );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	ulReferences = Atomic_Decrement_u32( &( pxBuffer->ulReferences ) );
+	configASSERT( ulReferences != 0U );
+
+	if( ulReferences == 1U )
+	{
+		traceREF_BUFFER_FREE( pxBuffer );
+
+		if( pxBuffer->pxPool != NULL )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xYieldRequired = prvReturnBuffer( pxBuffer );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			/* The heap cannot be used from an interrupt, so the timer task
+			frees the buffer.  If the timer queue is full, or there is no
+			timer task, the buffer is left for the next release from a
+			task. */
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+			BaseType_t xPended;
+
+				#if( ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) )
+				{
+					xPended = xTimerPendFunctionCallFromISR( prvFreeHeapBuffer, ( void * ) pxBuffer, 0UL, &xYieldRequired );
+				}
+				#else
+				{
+					xPended = pdFAIL;
+				}
+				#endif
+
+				if( xPended != pdPASS )
+				{
+					uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+					{
+						pxBuffer->pxNextFree = pxDeferredFreeBuffers;
+						pxDeferredFreeBuffers = pxBuffer;
+					}
+					portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+		}
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferSendToQueue( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, TickType_t xTicksToWait )
+{
+	configASSERT( xBuffer );
+
+	/* Only the handle is copied. */
+	return xQueueSendToBack( xQueue, &xBuffer, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferSendToQueueFromISR( QueueHandle_t xQueue, RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+	configASSERT( xBuffer );
+
+	return xQueueSendToBackFromISR( xQueue, &xBuffer, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferReceiveFromQueue( QueueHandle_t xQueue, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait )
+{
+	configASSERT( pxBuffer );
+
+	return xQueueReceive( xQueue, pxBuffer, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRefBufferSendToQueues( RefBufferHandle_t xBuffer, QueueHandle_t const * const pxQueues, UBaseType_t uxQueues, TickType_t xTicksToWait )
+{
+UBaseType_t uxQueue, uxSent = 0U;
+
+	configASSERT( xBuffer );
+	configASSERT( ( pxQueues != NULL ) || ( uxQueues == 0U ) );
+
+	for( uxQueue = 0U; uxQueue < uxQueues; uxQueue++ )
+	{
+		/* Take the reference of the receiver before it can see the buffer,
+		and give it up again if the queue stays full. */
+		vRefBufferRetain( xBuffer );
+
+		if( xQueueSendToBack( pxQueues[ uxQueue ], &xBuffer, xTicksToWait ) == pdPASS )
+		{
+			uxSent++;
+		}
+		else
+		{
+			vRefBufferRelease( xBuffer );
+		}
+	}
+
+	return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferSendToStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, TickType_t xTicksToWait )
+{
+size_t xBytes;
+
+	configASSERT( xBuffer );
+
+	/* A stream buffer writes as much of the handle as fits, so do not write
+	if there is not room for all of it.  A blocked send waits for room for all
+	of it, and once xTicksToWait expires only finds part of that room if the
+	stream buffer does not keep to the size rule in ref_buffer.h. */
+	if( ( xTicksToWait != ( TickType_t ) 0 ) || ( xStreamBufferSpacesAvailable( xStreamBuffer ) >= sizeof( xBuffer ) ) )
+	{
+		xBytes = xStreamBufferSend( xStreamBuffer, ( const void * ) &xBuffer, sizeof( xBuffer ), xTicksToWait );
+	}
+	else
+	{
+		xBytes = ( size_t ) 0;
+	}
+
+	configASSERT( ( xBytes == ( size_t ) 0 ) || ( xBytes == sizeof( xBuffer ) ) );
+
+	return ( xBytes == sizeof( xBuffer ) ) ? pdPASS : errQUEUE_FULL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferSendToStreamBufferFromISR( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t xBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+size_t xBytes;
+
+	configASSERT( xBuffer );
+
+	/* As xRefBufferSendToStreamBuffer(), there is no waiting here. */
+	if( xStreamBufferSpacesAvailable( xStreamBuffer ) >= sizeof( xBuffer ) )
+	{
+		xBytes = xStreamBufferSendFromISR( xStreamBuffer, ( const void * ) &xBuffer, sizeof( xBuffer ), pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		xBytes = ( size_t ) 0;
+	}
+
+	configASSERT( ( xBytes == ( size_t ) 0 ) || ( xBytes == sizeof( xBuffer ) ) );
+
+	return ( xBytes == sizeof( xBuffer ) ) ? pdPASS : errQUEUE_FULL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRefBufferReceiveFromStreamBuffer( StreamBufferHandle_t xStreamBuffer, RefBufferHandle_t * const pxBuffer, TickType_t xTicksToWait )
+{
+size_t xBytes;
+
+	configASSERT( pxBuffer );
+
+	xBytes = xStreamBufferReceive( xStreamBuffer, ( void * ) pxBuffer, sizeof( *pxBuffer ), xTicksToWait );
+	configASSERT( ( xBytes == ( size_t ) 0 ) || ( xBytes == sizeof( *pxBuffer ) ) );
+
+	return ( xBytes == sizeof( *pxBuffer ) ) ? pdPASS : errQUEUE_EMPTY;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRefBufferPoolGetFree( RefBufferPoolHandle_t xPool )
+{
+const RefBufferPool_t * const pxPool = xPool;
+
+	configASSERT( pxPool );
+
+	return pxPool->uxFreeBuffers;
+}
+/*-----------------------------------------------------------*/
+
+void vRefBufferPoolDelete( RefBufferPoolHandle_t xPool )
+{
+RefBufferPool_t * const pxPool = xPool;
+
+	configASSERT( pxPool );
+	configASSERT( pxPool->uxFreeBuffers == pxPool->uxBuffers );
+	configASSERT( listLIST_IS_EMPTY( &( pxPool->xTasksWaiting ) ) != pdFALSE );
+
+	traceREF_BUFFER_POOL_DELETE( pxPool );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxPool );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxPool );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static RefBuffer_t *prvTakeFreeBuffer( RefBufferPool_t * const pxPool )
+{
+RefBuffer_t * const pxBuffer = pxPool->pxFreeBuffers;
+
+	if( pxBuffer != NULL )
+	{
+		pxPool->pxFreeBuffers = pxBuffer->pxNextFree;
+		( pxPool->uxFreeBuffers )--;
+		pxBuffer->pxNextFree = NULL;
+		pxBuffer->ulReferences = 1U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReturnBuffer( RefBuffer_t * const pxBuffer )
+{
+RefBufferPool_t * const pxPool = pxBuffer->pxPool;
+BaseType_t xYieldRequired = pdFALSE;
+
+	pxBuffer->pxNextFree = pxPool->pxFreeBuffers;
+	pxPool->pxFreeBuffers = pxBuffer;
+	( pxPool->uxFreeBuffers )++;
+
+	if( listLIST_IS_EMPTY( &( pxPool->xTasksWaiting ) ) == pdFALSE )
+	{
+		xYieldRequired = xTaskRemoveFromEventList( &( pxPool->xTasksWaiting ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) )
+
+	static void prvFreeHeapBuffer( void *pvBuffer, uint32_t ulUnused )
+	{
+		( void ) ulUnused;
+		vPortFree( pvBuffer );
+		prvFreeDeferredBuffers();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static void prvFreeDeferredBuffers( void )
+	{
+	RefBuffer_t *pxBuffer;
+	RefBuffer_t *pxNext;
+
+		if( pxDeferredFreeBuffers != NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxBuffer = pxDeferredFreeBuffers;
+				pxDeferredFreeBuffers = NULL;
+			}
+			taskEXIT_CRITICAL();
+
+			while( pxBuffer != NULL )
+			{
+				pxNext = pxBuffer->pxNextFree;
+				vPortFree( pxBuffer );
+				pxBuffer = pxNext;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif
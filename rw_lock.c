@@ -0,0 +1,654 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "rw_lock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/* The whole state of the lock is one pointer sized word, so each fast path is
+a single compare-and-swap.  With rwlockWRITER_BIT set the rest of the word is
+the handle of the writer, otherwise it counts readers in units of
+rwlockONE_READER.  rwlockWAITERS_BIT is set while a task waits and sends every
+caller through the kernel.  Task handles are at least word aligned. */
+#define rwlockWAITERS_BIT			( ( portPOINTER_SIZE_TYPE ) 1U )
+#define rwlockWRITER_BIT			( ( portPOINTER_SIZE_TYPE ) 2U )
+#define rwlockFLAG_BITS				( rwlockWAITERS_BIT | rwlockWRITER_BIT )
+#define rwlockONE_READER			( ( portPOINTER_SIZE_TYPE ) 4U )
+
+#define rwlockWRITER( uxState )		( ( ( ( uxState ) & rwlockWRITER_BIT ) != 0U ) ? ( TaskHandle_t ) ( ( uxState ) & ~rwlockFLAG_BITS ) : NULL )
+
+#if( configUSE_PREEMPTION == 0 )
+	#define rwlockYIELD_IF_USING_PREEMPTION()
+#else
+	#define rwlockYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+typedef struct RWLockDef_t
+{
+	void * volatile pvState;			/*< Writer handle or reader count, see rwlockWRITER_BIT. */
+	List_t xReadersWaiting;				/*< Tasks blocked waiting to read, in priority order. */
+	List_t xWritersWaiting;				/*< Tasks blocked waiting to write, in priority order.  Readers wait while it is not empty. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The part of xRWLockReadTake() and xRWLockWriteTake() that runs when the
+ * lock cannot be taken with a compare-and-swap.
+ */
+static BaseType_t prvRWLockTakeContended( RWLock_t * const pxLock, const BaseType_t xWrite, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set or clear rwlockWAITERS_BIT to match the waiting tasks.  Called with the
+ * scheduler suspended or from a critical section.
+ */
+static void prvRWLockUpdateWaiters( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give the lock to the highest priority waiting writer and unblock it, so no
+ * other task can take the lock first.  Returns pdTRUE if the writer has a
+ * higher priority than the calling task.  Called from a critical section.
+ * Nothing takes the lock back if the writer is deleted or suspended before it
+ * runs, which rw_lock.h forbids.
+ */
+static BaseType_t prvRWLockWakeWriter( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every waiting reader.  Returns pdTRUE if one of them has a higher
+ * priority than the calling task.  Called from a critical section.
+ */
+static BaseType_t prvRWLockWakeReaders( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * The priority of the highest priority task waiting for the lock.
+ */
+static UBaseType_t prvRWLockWaitingPriority( const RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer )
+	{
+	RWLock_t *pxLock;
+
+		configASSERT( pxRWLockBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticRWLock_t equals the size of the real lock
+			structure. */
+			volatile size_t xSize = sizeof( StaticRWLock_t );
+			configASSERT( xSize == sizeof( RWLock_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxLock = ( RWLock_t * ) pxRWLockBuffer; /*lint !e740 !e9087 RWLock_t and StaticRWLock_t are deliberately aliased for data hiding purposes. */
+
+		if( pxLock != NULL )
+		{
+			pxLock->pvState = NULL;
+			vListInitialise( &( pxLock->xReadersWaiting ) );
+			vListInitialise( &( pxLock->xWritersWaiting ) );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxLock->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceRW_LOCK_CREATE( pxLock );
+		}
+		else
+		{
+			traceRW_LOCK_CREATE_FAILED();
+		}
+
+		return pxLock;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreate( void )
+	{
+	RWLock_t *pxLock;
+
+		pxLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxLock != NULL )
+		{
+			pxLock->pvState = NULL;
+			vListInitialise( &( pxLock->xReadersWaiting ) );
+			vListInitialise( &( pxLock->xWritersWaiting ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxLock->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceRW_LOCK_CREATE( pxLock );
+		}
+		else
+		{
+			traceRW_LOCK_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockReadTake( RWLockHandle_t xLock, TickType_t xTicksToWait )
+{
+RWLock_t * const pxLock = xLock;
+portPOINTER_SIZE_TYPE uxState;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxLock );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* Add a reader while no writer holds or waits.  The compare-and-swap
+	only fails repeatedly while other readers come and go. */
+	uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+
+	while( ( uxState & rwlockFLAG_BITS ) == 0U )
+	{
+		if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvState ), ( void * ) ( uxState + rwlockONE_READER ), ( void * ) uxState ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+		{
+			xReturn = pdPASS;
+			break;
+		}
+
+		uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+	}
+
+	if( xReturn == pdPASS )
+	{
+		traceRW_LOCK_READ_TAKE( pxLock );
+	}
+	else
+	{
+		/* A task that holds the lock for writing cannot read it as well. */
+		configASSERT( rwlockWRITER( uxState ) != xTaskGetCurrentTaskHandle() );
+
+		xReturn = prvRWLockTakeContended( pxLock, pdFALSE, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockReadGive( RWLockHandle_t xLock )
+{
+RWLock_t * const pxLock = xLock;
+portPOINTER_SIZE_TYPE uxState;
+BaseType_t xGiven = pdFALSE, xYieldRequired = pdFALSE;
+
+	configASSERT( pxLock );
+
+	traceRW_LOCK_READ_GIVE( pxLock );
+
+	uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+
+	while( ( uxState & rwlockWAITERS_BIT ) == 0U )
+	{
+		/* The lock must be held for reading. */
+		configASSERT( ( ( uxState & rwlockWRITER_BIT ) == 0U ) && ( uxState >= rwlockONE_READER ) );
+
+		if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvState ), ( void * ) ( uxState - rwlockONE_READER ), ( void * ) uxState ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+		{
+			xGiven = pdTRUE;
+			break;
+		}
+
+		uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+	}
+
+	if( xGiven == pdFALSE )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+			configASSERT( ( ( uxState & rwlockWRITER_BIT ) == 0U ) && ( uxState >= rwlockONE_READER ) );
+
+			uxState -= rwlockONE_READER;
+			pxLock->pvState = ( void * ) uxState;
+
+			/* The last reader lets a waiting writer in.  Readers only wait
+			with no writer waiting if the writer they waited behind was
+			deleted. */
+			if( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) == pdFALSE )
+			{
+				if( ( uxState & ~rwlockFLAG_BITS ) == 0U )
+				{
+					xYieldRequired = prvRWLockWakeWriter( pxLock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xYieldRequired = prvRWLockWakeReaders( pxLock );
+			}
+
+			prvRWLockUpdateWaiters( pxLock );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xYieldRequired != pdFALSE )
+		{
+			rwlockYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockWriteTake( RWLockHandle_t xLock, TickType_t xTicksToWait )
+{
+RWLock_t * const pxLock = xLock;
+TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+BaseType_t xReturn;
+
+	configASSERT( pxLock );
+	configASSERT( xCurrentTask );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvState ), ( void * ) ( ( portPOINTER_SIZE_TYPE ) xCurrentTask | rwlockWRITER_BIT ), NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+	{
+		/* Counted like a mutex so priority inheritance works. */
+		( void ) pvTaskIncrementMutexHeldCount();
+		traceRW_LOCK_WRITE_TAKE( pxLock );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		/* The lock is not recursive. */
+		configASSERT( rwlockWRITER( ( portPOINTER_SIZE_TYPE ) pxLock->pvState ) != xCurrentTask );
+
+		xReturn = prvRWLockTakeContended( pxLock, pdTRUE, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockWriteGive( RWLockHandle_t xLock )
+{
+RWLock_t * const pxLock = xLock;
+TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+BaseType_t xYieldRequired = pdFALSE;
+
+	configASSERT( pxLock );
+
+	/* Only the writer can give the lock. */
+	configASSERT( rwlockWRITER( ( portPOINTER_SIZE_TYPE ) pxLock->pvState ) == xCurrentTask );
+
+	traceRW_LOCK_WRITE_GIVE( pxLock );
+
+	/* The compare-and-swap only succeeds if no task waits. */
+	if( Atomic_CompareAndSwapPointers_p32( &( pxLock->pvState ), NULL, ( void * ) ( ( portPOINTER_SIZE_TYPE ) xCurrentTask | rwlockWRITER_BIT ) ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+	{
+		if( xTaskDecrementMutexHeldCount() != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			pxLock->pvState = NULL;
+
+			/* Writers are preferred, readers go in together when no writer
+			waits. */
+			if( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) == pdFALSE )
+			{
+				xYieldRequired = prvRWLockWakeWriter( pxLock );
+			}
+			else
+			{
+				xYieldRequired = prvRWLockWakeReaders( pxLock );
+			}
+
+			prvRWLockUpdateWaiters( pxLock );
+
+			if( xTaskPriorityDisinherit( xCurrentTask ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	if( xYieldRequired != pdFALSE )
+	{
+		rwlockYIELD_IF_USING_PREEMPTION();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xLock )
+{
+RWLock_t * const pxLock = xLock;
+
+	configASSERT( pxLock );
+	configASSERT( pxLock->pvState == NULL );
+
+	traceRW_LOCK_DELETE( pxLock );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxLock );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxLock );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRWLockTakeContended( RWLock_t * const pxLock, const BaseType_t xWrite, TickType_t xTicksToWait )
+{
+TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+List_t * const pxWaitingList = ( xWrite != pdFALSE ) ? &( pxLock->xWritersWaiting ) : &( pxLock->xReadersWaiting );
+BaseType_t xReturn = pdFAIL, xInheritanceOccurred = pdFALSE, xEntryTimeSet = pdFALSE, xCanTake;
+TimeOut_t xTimeOut;
+portPOINTER_SIZE_TYPE uxState;
+TaskHandle_t xWriter;
+
+	for( ;; )
+	{
+		/* Locks are not used from interrupts, so with the scheduler suspended
+		no other task can change the state word. */
+		vTaskSuspendAll();
+
+		uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+		xWriter = rwlockWRITER( uxState );
+
+		if( xWrite != pdFALSE )
+		{
+			/* A waiting writer is given the lock when it is unblocked. */
+			xCanTake = ( ( xWriter == xCurrentTask ) || ( ( uxState & ~rwlockWAITERS_BIT ) == 0U ) ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			/* New readers queue behind a waiting writer. */
+			xCanTake = ( ( xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) != pdFALSE ) ) ? pdTRUE : pdFALSE;
+		}
+
+		if( xCanTake != pdFALSE )
+		{
+			if( xWrite != pdFALSE )
+			{
+				pxLock->pvState = ( void * ) ( ( portPOINTER_SIZE_TYPE ) xCurrentTask | rwlockWRITER_BIT );
+				( void ) pvTaskIncrementMutexHeldCount();
+				traceRW_LOCK_WRITE_TAKE( pxLock );
+			}
+			else
+			{
+				pxLock->pvState = ( void * ) ( uxState + rwlockONE_READER );
+				traceRW_LOCK_READ_TAKE( pxLock );
+			}
+
+			prvRWLockUpdateWaiters( pxLock );
+			( void ) xTaskResumeAll();
+
+			xReturn = pdPASS;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			traceBLOCKING_ON_RW_LOCK_TAKE( pxLock );
+
+			pxLock->pvState = ( void * ) ( uxState | rwlockWAITERS_BIT );
+
+			/* Only a writer is known to the lock, so only a writer inherits. */
+			if( xWriter != NULL )
+			{
+				taskENTER_CRITICAL();
+				{
+					if( xTaskPriorityInherit( xWriter ) != pdFALSE )
+					{
+						xInheritanceOccurred = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vTaskPlaceOnEventList( pxWaitingList, xTicksToWait );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* Timed out.  This task has already been removed from the list of
+			waiting tasks. */
+			taskENTER_CRITICAL();
+			{
+				if( ( xInheritanceOccurred != pdFALSE ) && ( xWriter != NULL ) )
+				{
+					vTaskPriorityDisinheritAfterTimeout( xWriter, prvRWLockWaitingPriority( pxLock ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Readers held back only by this writer can go in. */
+				if( ( xWrite != pdFALSE ) && ( xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) != pdFALSE ) )
+				{
+					( void ) prvRWLockWakeReaders( pxLock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvRWLockUpdateWaiters( pxLock );
+			}
+			taskEXIT_CRITICAL();
+
+			( void ) xTaskResumeAll();
+
+			traceRW_LOCK_TAKE_FAILED( pxLock );
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRWLockUpdateWaiters( RWLock_t * const pxLock )
+{
+portPOINTER_SIZE_TYPE uxState = ( portPOINTER_SIZE_TYPE ) pxLock->pvState;
+
+	if( ( listLIST_IS_EMPTY( &( pxLock->xReadersWaiting ) ) == pdFALSE ) ||
+		( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) == pdFALSE ) )
+	{
+		uxState |= rwlockWAITERS_BIT;
+	}
+	else
+	{
+		uxState &= ~rwlockWAITERS_BIT;
+	}
+
+	pxLock->pvState = ( void * ) uxState;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRWLockWakeWriter( RWLock_t * const pxLock )
+{
+TaskHandle_t const xWriter = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xWritersWaiting ) ); /*lint !e9079 The owner of an event list item is its task. */
+
+	/* The writer counts itself as a mutex holder when it runs.  A task that
+	leaves the list by a timeout, delete or suspend is never given the
+	lock. */
+	pxLock->pvState = ( void * ) ( ( portPOINTER_SIZE_TYPE ) xWriter | rwlockWRITER_BIT );
+
+	return xTaskRemoveFromEventList( &( pxLock->xWritersWaiting ) );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRWLockWakeReaders( RWLock_t * const pxLock )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	while( listLIST_IS_EMPTY( &( pxLock->xReadersWaiting ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxLock->xReadersWaiting ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvRWLockWaitingPriority( const RWLock_t * const pxLock )
+{
+UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY, uxPriority;
+
+	if( listCURRENT_LIST_LENGTH( &( pxLock->xReadersWaiting ) ) > 0U )
+	{
+		uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xReadersWaiting ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( listCURRENT_LIST_LENGTH( &( pxLock->xWritersWaiting ) ) > 0U )
+	{
+		uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xWritersWaiting ) );
+
+		if( uxPriority > uxHighestPriorityOfWaitingTasks )
+		{
+			uxHighestPriorityOfWaitingTasks = uxPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxHighestPriorityOfWaitingTasks;
+}
+
+#endif /* configUSE_RW_LOCKS */
@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -152,6 +156,10 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		PollMemberHandle_t xPollMember;			/* The poll set member the buffer is, or NULL. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -398,6 +406,10 @@ BaseType_t xReturn = pdFAIL;
 	UBaseType_t uxStreamBufferNumber;
 #endif
 
+#if( configUSE_POLL_SETS == 1 )
+	PollMemberHandle_t xPollMember;
+#endif
+
 	configASSERT( pxStreamBuffer );
 
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -415,6 +427,13 @@ BaseType_t xReturn = pdFAIL;
 		{
 			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
 			{
+				#if( configUSE_POLL_SETS == 1 )
+				{
+					/* The reset must not take the buffer out of its poll set. */
+					xPollMember = pxStreamBuffer->xPollMember;
+				}
+				#endif
+
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
 											  pxStreamBuffer->pucBuffer,
 											  pxStreamBuffer->xLength,
@@ -428,6 +447,12 @@ BaseType_t xReturn = pdFAIL;
 				}
 				#endif
 
+				#if( configUSE_POLL_SETS == 1 )
+				{
+					pxStreamBuffer->xPollMember = xPollMember;
+				}
+				#endif
+
 				traceSTREAM_BUFFER_RESET( xStreamBuffer );
 			}
 		}
@@ -596,6 +621,30 @@ TimeOut_t xTimeOut;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		#if ( configUSE_POLL_SETS == 1 )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxStreamBuffer->xPollMember != NULL )
+				{
+					if( xPollSetSignal( pxStreamBuffer->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		#endif /* configUSE_POLL_SETS */
 	}
 	else
 	{
@@ -646,6 +695,32 @@ size_t xRequiredSpace = xDataLengthBytes;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		#if ( configUSE_POLL_SETS == 1 )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				if( pxStreamBuffer->xPollMember != NULL )
+				{
+					if( ( xPollSetSignal( pxStreamBuffer->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#endif /* configUSE_POLL_SETS */
 	}
 	else
 	{
@@ -1261,3 +1336,33 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xStreamBufferSetPollMember( StreamBufferHandle_t xStreamBuffer, PollMemberHandle_t xMember )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	BaseType_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( xMember != NULL ) && ( pxStreamBuffer->xPollMember != NULL ) )
+			{
+				/* Cannot add a stream buffer to more than one poll set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxStreamBuffer->xPollMember = xMember;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
@@ -37,8 +37,12 @@ task.h is included from an application file. */
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 #include "timers.h"
 #include "stack_macros.h"
+#if ( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
 #if CONFIG_FTRACE
 #include "ftrace.h"
 #endif
@@ -92,6 +96,22 @@ set then don't fill the stack so there is no unnecessary dependency on memset. *
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	0
 #endif
 
+/* When the heap keeps a pool of blocks already filled with tskSTACK_FILL_BYTE
+the stacks allocated by xTaskCreate() are taken from it, and
+prvInitialiseNewTask() only has to fill stacks that were supplied by the
+application. */
+#if( ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 ) && defined( CONFIG_HEAP_PREFILL_POOL ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define tskMALLOC_STACK( xSize )	pvPortMallocFilled( ( xSize ), ( uint8_t ) tskSTACK_FILL_BYTE )
+	#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+		#define tskSTACK_NEEDS_FILL( pxTCB )	( ( pxTCB )->ucStaticallyAllocated != tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+	#else
+		#define tskSTACK_NEEDS_FILL( pxTCB )	pdFALSE
+	#endif
+#else
+	#define tskMALLOC_STACK( xSize )	pvPortMalloc( xSize )
+	#define tskSTACK_NEEDS_FILL( pxTCB )	pdTRUE
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -115,7 +135,92 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* The EDF priority band is kept sorted by absolute deadline, so the task
+	at its head runs rather than the tasks taking turns. */
+	#define taskGET_NEXT_READY_TASK( uxPriority )														\
+	{																									\
+		if( ( uxPriority ) == configEDF_PRIORITY )														\
+		{																								\
+			pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );		\
+		}																								\
+	}
+
+	/* A ready task preempts the running task of the EDF band when its deadline
+	is earlier. */
+	#define taskEDF_PREEMPTS( pxTCB )																	\
+		( ( ( pxTCB )->uxPriority == configEDF_PRIORITY ) &&											\
+		  ( pxCurrentTCB->uxPriority == configEDF_PRIORITY ) &&											\
+		  ( prvEdfDeadlineBefore( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) )
+
+	/* The EDF band is not time sliced, its head runs until it blocks. */
+	#define taskIS_TIME_SLICED( uxPriority )	( ( uxPriority ) != configEDF_PRIORITY )
+
+#else
+
+	#define taskGET_NEXT_READY_TASK( uxPriority )	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+	#define taskEDF_PREEMPTS( pxTCB )				( pdFALSE )
+	#define taskIS_TIME_SLICED( uxPriority )		( pdTRUE )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configUSE_TASK_TIME_SLICE == 1 )
+	#define taskTIME_SLICE_USED()	prvTimeSliceUsed()
+#else
+	#define taskTIME_SLICE_USED()	( pdTRUE )
+#endif
+
+#if ( ( configUSE_TASK_TIME_SLICE == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+	/* A task of the running task's priority unblocked by the tick waits for
+	the running task's quantum to be used up, which the time slicing in
+	xTaskIncrementTick() checks, unless the priority is not time sliced. */
+	#define taskTICK_UNBLOCK_PREEMPTS( uxOtherPriority )									\
+		( ( taskPREEMPTS_CURRENT( uxOtherPriority ) ) &&									\
+		  ( ( ( uxOtherPriority ) != pxCurrentTCB->uxPriority ) || ( taskIS_TIME_SLICED( uxOtherPriority ) == pdFALSE ) ) )
+
+#else
+
+	#define taskTICK_UNBLOCK_PREEMPTS( uxOtherPriority )	taskPREEMPTS_CURRENT( uxOtherPriority )
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	/* A task raised to its preemption threshold keeps its priority, but is
+	only preempted by tasks above the threshold, and does not share its time
+	with tasks at or below the threshold. */
+	#define taskTHRESHOLD_PRIORITY( pxTCB )																	\
+		( ( ( ( pxTCB )->ucThresholdRaised != pdFALSE ) && ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority ) ) ?	\
+		  ( pxTCB )->uxPreemptionThreshold : ( pxTCB )->uxPriority )
+	#define taskTHRESHOLD_RAISED()		( pxCurrentTCB->ucThresholdRaised != pdFALSE )
+	#define taskRUNNING_PRIORITY()		taskTHRESHOLD_PRIORITY( pxCurrentTCB )
+	#define taskPREEMPTS_CURRENT( uxOtherPriority )										\
+		( ( ( uxOtherPriority ) > taskRUNNING_PRIORITY() ) ||							\
+		  ( ( ( uxOtherPriority ) == pxCurrentTCB->uxPriority ) && ( taskTHRESHOLD_RAISED() == pdFALSE ) ) )
+
+#else
+
+	#define taskTHRESHOLD_RAISED()						( pdFALSE )
+	#define taskRUNNING_PRIORITY()						( pxCurrentTCB->uxPriority )
+	#define taskPREEMPTS_CURRENT( uxOtherPriority )	( ( uxOtherPriority ) >= pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+#if ( configUSE_TASK_BUDGET == 1 )
+	#define taskBUDGET_CLAMP_PRIORITY( pxTCB, uxPriority )	prvTaskBudgetClampPriority( ( pxTCB ), ( uxPriority ) )
+#else
+	#define taskBUDGET_CLAMP_PRIORITY( pxTCB, uxPriority )	( uxPriority )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -133,20 +238,29 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 	/*-----------------------------------------------------------*/
 
-	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	#define taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority )											\
 	{																									\
-	UBaseType_t uxTopPriority = uxTopReadyPriority;														\
+		( uxTopPriority ) = uxTopReadyPriority;															\
 																										\
 		/* Find the highest priority queue that contains ready tasks. */								\
-		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )							\
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) ) )						\
 		{																								\
 			configASSERT( uxTopPriority );																\
-			--uxTopPriority;																			\
+			--( uxTopPriority );																		\
 		}																								\
+	} /* taskFIND_HIGHEST_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopPriority;																			\
+																										\
+		taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority );												\
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskGET_NEXT_READY_TASK( uxTopPriority );														\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -158,6 +272,83 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+
+	/* If configUSE_PRIORITY_BITMAP_TASK_SELECTION is 1 then the ready
+	priorities are kept in a two level bitmap of 32 bit words.  A bit in
+	ulReadyGroups is set when the matching word of ulReadyPriorities is not
+	zero, so the highest ready priority is found with two count leading zeros
+	operations for up to 1024 priorities. */
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PRIORITY_BITMAP_TASK_SELECTION supports at most 1024 priorities.
+	#endif
+
+	#define taskREADY_BITMAP_WORDS		( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+	#ifndef portCOUNT_LEADING_ZEROS_32
+		#if defined( __GNUC__ ) && ( defined( __aarch64__ ) || defined( __ARM_FEATURE_CLZ ) || defined( __riscv_zbb ) || defined( __XTENSA__ ) )
+			/* Compiles to clz on ARM and RISC-V with Zbb, and to nsau on
+			Xtensa. */
+			#define portCOUNT_LEADING_ZEROS_32( ulValue )	( ( UBaseType_t ) __builtin_clz( ulValue ) )
+		#else
+			#define portCOUNT_LEADING_ZEROS_32( ulValue )	prvCountLeadingZeros32( ulValue )
+			#define taskUSE_GENERIC_COUNT_LEADING_ZEROS	1
+		#endif
+	#endif
+
+	#define taskTOP_BIT_32( ulValue )	( ( UBaseType_t ) 31U - portCOUNT_LEADING_ZEROS_32( ulValue ) )
+
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		ulReadyPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31UL ) );				\
+		ulReadyGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );											\
+	} /* taskRECORD_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority )											\
+	{																									\
+	UBaseType_t uxTopGroup;																				\
+																										\
+		/* The idle task is always ready, so ulReadyGroups is never 0. */								\
+		configASSERT( ulReadyGroups );																	\
+		uxTopGroup = taskTOP_BIT_32( ulReadyGroups );													\
+		( uxTopPriority ) = ( uxTopGroup << 5 ) | taskTOP_BIT_32( ulReadyPriorities[ uxTopGroup ] );	\
+	} /* taskFIND_HIGHEST_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopPriority;																			\
+																										\
+		taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority );												\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+		taskGET_NEXT_READY_TASK( uxTopPriority );														\
+		uxTopReadyPriority = uxTopPriority;																\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+	/*-----------------------------------------------------------*/
+
+	/* Clear the bit of a priority whose ready list became empty, and the group
+	bit with the last one of its word. */
+	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )									\
+	{																									\
+		ulReadyPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) );				\
+		if( ulReadyPriorities[ ( uxPriority ) >> 5 ] == 0UL )											\
+		{																								\
+			ulReadyGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );										\
+		}																								\
+	}
+
+	#define taskRESET_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
+		{																								\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+		}																								\
+	}
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -169,14 +360,18 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 	/*-----------------------------------------------------------*/
 
+	/* Find the highest priority list that contains ready tasks. */
+	#define taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority )	portGET_HIGHEST_PRIORITY( ( uxTopPriority ), uxTopReadyPriority )
+
+	/*-----------------------------------------------------------*/
+
 	#define taskSELECT_HIGHEST_PRIORITY_TASK()														\
 	{																								\
 	UBaseType_t uxTopPriority;																		\
 																									\
-		/* Find the highest priority list that contains ready tasks. */								\
-		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+		taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority );											\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskGET_NEXT_READY_TASK( uxTopPriority );													\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -216,13 +411,38 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or at its deadline in the
+ * EDF priority band.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#define taskINSERT_READY_LIST( pxTCB )															\
+	{																								\
+		if( ( pxTCB )->uxPriority == configEDF_PRIORITY )											\
+		{																							\
+			prvEdfInsertReady( pxTCB );																\
+		}																							\
+		else																						\
+		{																							\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																							\
+	}
+#else
+	#define taskINSERT_READY_LIST( pxTCB )	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+#endif
+
+#define taskADD_TO_READY_LIST( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_READY_LIST( pxTCB );																	\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#if ( configUSE_PARTITIONS == 1 )
+	/* The ready tasks of a partition outside its window are held in the ready
+	list of the partition instead. */
+	#define prvAddTaskToReadyList( pxTCB )	prvPartitionAddToReadyList( pxTCB )
+#else
+	#define prvAddTaskToReadyList( pxTCB )	taskADD_TO_READY_LIST( pxTCB )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -309,8 +529,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -330,6 +550,43 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		void *pxTaskFun;
 		void *pxTaskPara;
 	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xEdfPeriod;				/*< Period of an EDF task, 0 for fixed priority tasks. */
+		TickType_t		xEdfRelativeDeadline;
+		TickType_t		xEdfBudget;
+		TickType_t		xEdfAbsoluteDeadline;	/*< Deadline of the current job, orders the EDF band. */
+	#endif
+	#if ( configUSE_TASK_BUDGET == 1 )
+		struct tskTaskBudget *pxBudget;					/*< The CPU budget the task is charged to, NULL if none. */
+		struct tskTaskControlBlock *pxNextBudgetTask;	/*< Next task charged to the same budget. */
+		UBaseType_t		uxBudgetPriority;				/*< The priority to restore when a demoted task gets its budget back. */
+		uint8_t			ucBudgetState;
+	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxPreemptionThreshold;		/*< Only tasks above this priority can preempt the task once it runs. */
+		struct tskTaskControlBlock *pxNextThresholdRaised;	/*< Next task in pxThresholdRaisedTasks. */
+		uint8_t			ucThresholdRaised;			/*< pdTRUE from when the task is switched in until it leaves the Ready state. */
+	#endif
+	#if ( configUSE_TASK_TIME_SLICE == 1 )
+		TickType_t		xTimeSlice;				/*< Round robin quantum in ticks. */
+		TickType_t		xTimeSliceRemaining;	/*< Ticks left of the quantum, kept while the task blocks. */
+	#endif
+	#if ( configUSE_PARTITIONS == 1 )
+		UBaseType_t		uxPartition;			/*< The partition the task runs in, 0 for the system partition. */
+	#endif
+	#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+		List_t			xMutexesHeld;			/*< The mutexes held by the task, their priorities are what the task inherits. */
+		void			*pvMutexBlockedOn;		/*< The mutex the task is waiting for, NULL if none. */
+	#endif
+	#if ( configUSE_POLL_SETS == 1 )
+		PollMemberHandle_t	xPollMember;		/*< The poll set member the task's notifications are, or NULL. */
+	#endif
+	#if ( configUSE_QUEUE_HANDOFF == 1 )
+		void			*pvHandoffBuffer;		/*< Where a sender copies the item the task is blocked in xQueueReceive() for, NULL once it has. */
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		uint8_t			ucMovedToMutex;			/*< Set to pdTRUE when a condition variable moves the task to wait for its mutex. */
+	#endif
 	#if ENABLE_KASAN
 		int kasan_depth;
 	#endif
@@ -395,6 +652,72 @@ when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Utilisation admitted to the EDF band, taskEDF_FULL_UTILISATION is 1. */
+	#define taskEDF_FULL_UTILISATION	( ( uint32_t ) 0x10000UL )
+	PRIVILEGED_DATA static uint32_t ulEdfUtilisation = 0UL;
+
+#endif
+
+#if ( configUSE_TASK_BUDGET == 1 )
+
+	/* Values that can be assigned to the ucBudgetState member of the TCB. */
+	#define taskBUDGET_NOT_THROTTLED	( ( uint8_t ) 0 )
+	#define taskBUDGET_DEMOTED			( ( uint8_t ) 1 )
+	#define taskBUDGET_SUSPENDED		( ( uint8_t ) 2 )
+
+	typedef struct tskTaskBudget
+	{
+		TickType_t xBudget;						/*< Ticks allowed per period. */
+		TickType_t xPeriod;
+		TickType_t xRemaining;					/*< Ticks left in the current period. */
+		TickType_t xNextReplenish;				/*< Tick count at which the current period ends. */
+		eTaskBudgetAction eAction;
+		TaskBudgetOverrunHook_t pxOverrunHook;
+		TCB_t *pxFirstTask;						/*< Tasks charged to the budget, linked through pxNextBudgetTask. */
+		struct tskTaskBudget *pxNextBudget;		/*< Next budget in pxTaskBudgets. */
+	} TaskBudget_t;
+
+	PRIVILEGED_DATA static TaskBudget_t *pxTaskBudgets = NULL;	/*< All budgets, replenished from the tick interrupt. */
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	PRIVILEGED_DATA static TCB_t *pxThresholdRaisedTasks = NULL;	/*< Ready tasks raised to their threshold, the last raised first. */
+
+#endif
+
+#if ( configUSE_PARTITIONS == 1 )
+
+	PRIVILEGED_DATA static List_t xPartitionReadyLists[ configNUM_PARTITIONS ];	/*< Ready tasks of the partitions outside their window. */
+	PRIVILEGED_DATA static const PartitionWindow_t *pxPartitionWindows = NULL;	/*< The major frame, NULL until a schedule is installed. */
+	PRIVILEGED_DATA static UBaseType_t uxPartitionWindowCount = 0U;
+	PRIVILEGED_DATA static UBaseType_t uxPartitionWindow = 0U;					/*< Index of the current window in pxPartitionWindows. */
+	PRIVILEGED_DATA static UBaseType_t uxActivePartition = 0U;					/*< The partition that owns the current window. */
+	PRIVILEGED_DATA static TickType_t xPartitionWindowEnd = 0U;
+
+	#if ( configPARTITION_BACKGROUND != 0 )
+		PRIVILEGED_DATA static BaseType_t xPartitionDonated = pdFALSE;			/*< pdTRUE while the background partition runs in the idle time of the window. */
+		#define taskPARTITION_DONATED( uxPartition )	( ( xPartitionDonated != pdFALSE ) && ( ( uxPartition ) == ( UBaseType_t ) configPARTITION_BACKGROUND ) )
+	#else
+		#define taskPARTITION_DONATED( uxPartition )	( pdFALSE )
+	#endif
+
+	/* The system partition runs in every window, and every partition runs
+	until a schedule is installed. */
+	#define taskPARTITION_CAN_RUN( uxPartition )		( ( ( uxPartition ) == ( UBaseType_t ) 0U ) || ( ( uxPartition ) == uxActivePartition ) || ( pxPartitionWindows == NULL ) || taskPARTITION_DONATED( uxPartition ) )
+
+#endif
+
+#if ( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+
+	PRIVILEGED_DATA static volatile uint32_t ulReadyGroups = 0UL;							/*< Bit n is set when word n of ulReadyPriorities is not 0. */
+	PRIVILEGED_DATA static volatile uint32_t ulReadyPriorities[ taskREADY_BITMAP_WORDS ];	/*< One bit per priority that has ready tasks. */
+
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	/* Do not move these variables to function scope as doing so prevents the
@@ -541,6 +864,165 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Returns pdTRUE if pxTCB has to run before pxOtherTCB in the EDF band.
+	 * Tasks without a deadline, such as tasks that inherited the band priority,
+	 * run first.
+	 */
+	static BaseType_t prvEdfDeadlineBefore( const TCB_t * const pxTCB, const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Insert pxTCB into the EDF band ready list, ordered by absolute deadline.
+	 */
+	static void prvEdfInsertReady( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Density of an EDF task in 1/0x10000 units, rounded up.
+	 */
+	static uint32_t prvEdfUtilisation( const TickType_t xBudget, const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_BUDGET == 1 )
+
+	/*
+	 * Charge the tick to the budget of the running task and replenish the
+	 * budgets whose period ends.  Called from xTaskIncrementTick(), returns
+	 * pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvTaskBudgetTick( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Demote or suspend a task that is in its ready list.
+	 */
+	static void prvTaskBudgetThrottle( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Undo prvTaskBudgetThrottle(), returns pdTRUE if the task should preempt
+	 * the running task.
+	 */
+	static BaseType_t prvTaskBudgetRelease( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the priority to restore a task to, which is the background
+	 * priority while the task is demoted.  The priority asked for is then
+	 * kept for when the budget is replenished.
+	 */
+	static UBaseType_t prvTaskBudgetClampPriority( TCB_t * const pxTCB, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Release the task and remove it from the task list of its budget.
+	 */
+	static BaseType_t prvTaskBudgetDetach( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	/*
+	 * Raise a task that is switched in to its preemption threshold.  Its
+	 * priority and its place in the ready lists do not change.
+	 */
+	static void prvPreemptionThresholdRaise( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Undo prvPreemptionThresholdRaise(), returns pdTRUE if the task was
+	 * raised.
+	 */
+	static BaseType_t prvPreemptionThresholdRestore( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Make the raised task with the highest threshold the running task if no
+	 * ready task is above that threshold, so a preempted task resumes ahead of
+	 * the tasks at or below its threshold.  Returns pdFALSE if the highest
+	 * priority task should be selected as usual.
+	 */
+	static BaseType_t prvPreemptionThresholdSelect( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_TIME_SLICE == 1 )
+
+	/*
+	 * Charge a tick to the quantum of the running task, returns pdTRUE and
+	 * starts a new quantum once it is used up.
+	 */
+	static BaseType_t prvTimeSliceUsed( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PARTITIONS == 1 )
+
+	/*
+	 * Add a task to its ready list, or to the ready list of its partition if
+	 * the partition cannot run now.
+	 */
+	static void prvPartitionAddToReadyList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move a task from its ready list to the ready list of its partition.
+	 */
+	static void prvPartitionParkTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the ready tasks of a partition, except the running task, out of the
+	 * ready lists.  The running task follows when it is switched out.
+	 */
+	static void prvPartitionPark( const UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the ready tasks of a partition back into the ready lists.
+	 */
+	static void prvPartitionUnpark( const UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Start the next window of the major frame.  Called from the tick.
+	 */
+	static void prvPartitionNextWindow( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+
+	/*
+	 * Raise the priority of the holder of a mutex to uxInheritedPriority, the
+	 * priority of a task waiting for the mutex, if that is higher.  Returns
+	 * pdTRUE if the holder has inherited a priority from the waiting task.
+	 */
+	static BaseType_t prvTaskPriorityInherit( TCB_t * const pxMutexHolderTCB, const UBaseType_t uxInheritedPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+	/*
+	 * Set the priority of a task to the highest of its base priority, the
+	 * priority each held mutex demands and uxFloor.  A task waiting for a
+	 * mutex is moved to its new position among the waiters.  Returns pdTRUE
+	 * if the priority changed.
+	 */
+	static BaseType_t prvMutexUpdatePriority( TCB_t * const pxTCB, const UBaseType_t uxFloor ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Update the priority of pxTCB, then of the holder of the mutex pxTCB is
+	 * waiting for and so on, until a priority does not change.
+	 */
+	static void prvMutexPropagate( TCB_t *pxTCB, UBaseType_t uxFloor ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#ifdef taskUSE_GENERIC_COUNT_LEADING_ZEROS
+
+	/*
+	 * Portable count leading zeros for the priority bitmap, used when the
+	 * target has no instruction for it.  ulValue must not be 0.
+	 */
+	static UBaseType_t prvCountLeadingZeros32( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -763,7 +1245,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) tskMALLOC_STACK( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
@@ -778,7 +1260,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+			pxStack = tskMALLOC_STACK( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
 			if( pxStack != NULL )
 			{
@@ -828,35 +1310,119 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
-#if ( configUSE_TASK_START_HOOK == 1 )
-static void prvTaskFunWrp( void *para)
-{
-	TCB_t *pxNewTCB = (TCB_t *)para;
-	{
 
-		extern void vApplicationTaskStartHook( void );
-		vApplicationTaskStartHook();
-	}
-	((TaskFunction_t)pxNewTCB->pxTaskFun)(pxNewTCB->pxTaskPara);
-}
-#endif
-static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+
+	BaseType_t xTaskCreateDeadline(	TaskFunction_t pxTaskCode,
 									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-									const uint32_t ulStackDepth,
-									void * pvParameters,
-									UBaseType_t uxPriority,
-									TaskHandle_t * const pxCreatedTask,
-									TCB_t *pxNewTCB,
-									const MemoryRegion_t * const xRegions )
-{
-StackType_t *pxTopOfStack;
-UBaseType_t x;
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									const TickType_t xPeriod,
+									const TickType_t xRelativeDeadline,
+									const TickType_t xBudget,
+									TaskHandle_t * const pxCreatedTask )
+	{
+	TCB_t *pxNewTCB;
+	TaskHandle_t xHandle = NULL;
+	BaseType_t xReturn;
+	uint32_t ulUtilisation;
 
-	#if( portUSING_MPU_WRAPPERS == 1 )
-		/* Should the task be created in privileged mode? */
-		BaseType_t xRunPrivileged;
-		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
-		{
+		configASSERT( xPeriod > 0U );
+		configASSERT( ( xRelativeDeadline > 0U ) && ( xRelativeDeadline <= xPeriod ) );
+		configASSERT( ( xBudget > 0U ) && ( xBudget <= xRelativeDeadline ) );
+
+		/* Admission control.  The band stays schedulable while the sum of the
+		densities, budget over relative deadline, is not above 1. */
+		ulUtilisation = prvEdfUtilisation( xBudget, xRelativeDeadline );
+
+		taskENTER_CRITICAL();
+		{
+			if( ulUtilisation <= ( taskEDF_FULL_UTILISATION - ulEdfUtilisation ) )
+			{
+				ulEdfUtilisation += ulUtilisation;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn == pdPASS )
+		{
+			/* The task must not run before it has its deadline. */
+			vTaskSuspendAll();
+			{
+				xReturn = xTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, configEDF_PRIORITY, &xHandle );
+
+				taskENTER_CRITICAL();
+				{
+					if( xReturn == pdPASS )
+					{
+						pxNewTCB = xHandle;
+						pxNewTCB->xEdfPeriod = xPeriod;
+						pxNewTCB->xEdfRelativeDeadline = xRelativeDeadline;
+						pxNewTCB->xEdfBudget = xBudget;
+
+						/* The first job is released now. */
+						pxNewTCB->xEdfAbsoluteDeadline = xTickCount + xRelativeDeadline;
+						( void ) uxListRemove( &( pxNewTCB->xStateListItem ) );
+						prvEdfInsertReady( pxNewTCB );
+					}
+					else
+					{
+						ulEdfUtilisation -= ulUtilisation;
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+			( void ) xTaskResumeAll();
+
+			if( pxCreatedTask != NULL )
+			{
+				*pxCreatedTask = xHandle;
+			}
+		}
+		else
+		{
+			traceTASK_CREATE_FAILED();
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+#if ( configUSE_TASK_START_HOOK == 1 )
+static void prvTaskFunWrp( void *para)
+{
+	TCB_t *pxNewTCB = (TCB_t *)para;
+	{
+
+		extern void vApplicationTaskStartHook( void );
+		vApplicationTaskStartHook();
+	}
+	((TaskFunction_t)pxNewTCB->pxTaskFun)(pxNewTCB->pxTaskPara);
+}
+#endif
+static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const uint32_t ulStackDepth,
+									void * pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TCB_t *pxNewTCB,
+									const MemoryRegion_t * const xRegions )
+{
+StackType_t *pxTopOfStack;
+UBaseType_t x;
+
+	#if( portUSING_MPU_WRAPPERS == 1 )
+		/* Should the task be created in privileged mode? */
+		BaseType_t xRunPrivileged;
+		if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+		{
 			xRunPrivileged = pdTRUE;
 		}
 		else
@@ -881,8 +1447,16 @@ UBaseType_t x;
 	/* Avoid dependency on memset() if it is not required. */
 	#if( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
 	{
-		/* Fill the stack with a known value to assist debugging. */
-		( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+		/* Fill the stack with a known value to assist debugging, unless the
+		stack came from the heap already filled. */
+		if( tskSTACK_NEEDS_FILL( pxNewTCB ) != pdFALSE )
+		{
+			( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 	#endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
@@ -969,6 +1543,31 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+	{
+		vListInitialise( &( pxNewTCB->xMutexesHeld ) );
+		pxNewTCB->pvMutexBlockedOn = NULL;
+	}
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+	{
+		pxNewTCB->xPollMember = NULL;
+	}
+	#endif
+
+	#if ( configUSE_QUEUE_HANDOFF == 1 )
+	{
+		pxNewTCB->pvHandoffBuffer = NULL;
+	}
+	#endif
+
+	#if ( configUSE_MUTEXES == 1 )
+	{
+		pxNewTCB->ucMovedToMutex = pdFALSE;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -1020,8 +1619,8 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		( void ) memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		( void ) memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), taskNOT_WAITING_NOTIFICATION, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -1038,6 +1637,45 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xEdfPeriod = 0U;
+		pxNewTCB->xEdfRelativeDeadline = 0U;
+		pxNewTCB->xEdfBudget = 0U;
+		pxNewTCB->xEdfAbsoluteDeadline = 0U;
+	}
+	#endif
+
+	#if ( configUSE_TASK_BUDGET == 1 )
+	{
+		pxNewTCB->pxBudget = NULL;
+		pxNewTCB->pxNextBudgetTask = NULL;
+		pxNewTCB->uxBudgetPriority = uxPriority;
+		pxNewTCB->ucBudgetState = taskBUDGET_NOT_THROTTLED;
+	}
+	#endif
+
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		pxNewTCB->uxPreemptionThreshold = tskIDLE_PRIORITY;
+		pxNewTCB->pxNextThresholdRaised = NULL;
+		pxNewTCB->ucThresholdRaised = pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_TASK_TIME_SLICE == 1 )
+	{
+		pxNewTCB->xTimeSlice = ( TickType_t ) configDEFAULT_TIME_SLICE;
+		pxNewTCB->xTimeSliceRemaining = ( TickType_t ) configDEFAULT_TIME_SLICE;
+	}
+	#endif
+
+	#if ( configUSE_PARTITIONS == 1 )
+	{
+		pxNewTCB->uxPartition = 0U;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1170,7 +1808,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( ( taskRUNNING_PRIORITY() < pxNewTCB->uxPriority ) || taskEDF_PREEMPTS( pxNewTCB ) )
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1218,6 +1856,29 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configUSE_EDF_SCHEDULING == 1 )
+			{
+				/* Give the utilisation of an EDF task back to the band. */
+				if( pxTCB->xEdfPeriod != 0U )
+				{
+					ulEdfUtilisation -= prvEdfUtilisation( pxTCB->xEdfBudget, pxTCB->xEdfRelativeDeadline );
+					pxTCB->xEdfPeriod = 0U;
+				}
+			}
+			#endif
+
+			#if ( configUSE_TASK_BUDGET == 1 )
+			{
+				( void ) prvTaskBudgetDetach( pxTCB );
+			}
+			#endif
+
+			#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+			{
+				( void ) prvPreemptionThresholdRestore( pxTCB );
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1336,6 +1997,32 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
+			#if ( configUSE_EDF_SCHEDULING == 1 )
+			{
+				/* The next job of an EDF task is released at the wake time. */
+				if( pxCurrentTCB->xEdfPeriod != 0U )
+				{
+					pxCurrentTCB->xEdfAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xEdfRelativeDeadline;
+
+					/* A late task is released at once, move it to its new
+					place in the band. */
+					if( ( xShouldDelay == pdFALSE ) && ( pxCurrentTCB->uxPriority == configEDF_PRIORITY ) )
+					{
+						( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+						prvEdfInsertReady( pxCurrentTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			if( xShouldDelay != pdFALSE )
 			{
 				traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -1453,17 +2140,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t uxIndex;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( uxIndex = 0U; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1614,7 +2305,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 						/* The priority of a task other than the currently
 						running task is being raised.  Is the priority being
 						raised above that of the running task? */
-						if( uxNewPriority >= pxCurrentTCB->uxPriority )
+						if( taskPREEMPTS_CURRENT( uxNewPriority ) )
 						{
 							xYieldRequired = pdTRUE;
 						}
@@ -1655,8 +2346,17 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					currently using an inherited priority. */
 					if( pxTCB->uxBasePriority == pxTCB->uxPriority )
 					{
-						pxTCB->uxPriority = uxNewPriority;
+						pxTCB->uxPriority = taskBUDGET_CLAMP_PRIORITY( pxTCB, uxNewPriority );
+					}
+					#if ( configUSE_TASK_BUDGET == 1 )
+					else if( ( pxTCB->ucBudgetState == taskBUDGET_DEMOTED ) && ( pxTCB->uxBasePriority == pxTCB->uxBudgetPriority ) )
+					{
+						/* The task is demoted rather than using an inherited
+						priority, it uses the new priority once its budget is
+						replenished. */
+						pxTCB->uxBudgetPriority = uxNewPriority;
 					}
+					#endif
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
@@ -1667,7 +2367,23 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 				#else
 				{
-					pxTCB->uxPriority = uxNewPriority;
+					pxTCB->uxPriority = taskBUDGET_CLAMP_PRIORITY( pxTCB, uxNewPriority );
+				}
+				#endif
+
+				#if ( configUSE_EDF_SCHEDULING == 1 )
+				{
+					/* An EDF task moved out of the EDF band becomes a fixed
+					priority task and gives its utilisation back. */
+					if( ( pxTCB->xEdfPeriod != 0U ) && ( uxNewPriority != ( UBaseType_t ) configEDF_PRIORITY ) )
+					{
+						ulEdfUtilisation -= prvEdfUtilisation( pxTCB->xEdfBudget, pxTCB->xEdfRelativeDeadline );
+						pxTCB->xEdfPeriod = 0U;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				#endif
 
@@ -1729,91 +2445,404 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TASK_BUDGET == 1 ) )
 
-	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	TaskBudgetHandle_t xTaskBudgetCreate( const TickType_t xBudget, const TickType_t xPeriod, const eTaskBudgetAction eAction, const TaskBudgetOverrunHook_t pxOverrunHook )
+	{
+	TaskBudget_t *pxBudget;
+
+		configASSERT( ( xBudget > 0U ) && ( xBudget <= xPeriod ) );
+
+		#if ( INCLUDE_vTaskSuspend == 0 )
+		{
+			/* Budgets can only suspend tasks if vTaskSuspend() is included. */
+			configASSERT( eAction == eTaskBudgetDemote );
+		}
+		#endif
+
+		pxBudget = ( TaskBudget_t * ) pvPortMalloc( sizeof( TaskBudget_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the budget structure. */
+
+		if( pxBudget != NULL )
+		{
+			pxBudget->xBudget = xBudget;
+			pxBudget->xPeriod = xPeriod;
+			pxBudget->xRemaining = xBudget;
+			pxBudget->eAction = eAction;
+			pxBudget->pxOverrunHook = pxOverrunHook;
+			pxBudget->pxFirstTask = NULL;
+
+			taskENTER_CRITICAL();
+			{
+				/* The first period starts now. */
+				pxBudget->xNextReplenish = xTickCount + xPeriod;
+				pxBudget->pxNextBudget = pxTaskBudgets;
+				pxTaskBudgets = pxBudget;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxBudget;
+	}
+
+#endif /* ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TASK_BUDGET == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGET == 1 )
+
+	void vTaskBudgetAttach( TaskHandle_t xTask, TaskBudgetHandle_t xBudget )
 	{
 	TCB_t *pxTCB;
 
 		taskENTER_CRITICAL();
 		{
-			/* If null is passed in here then it is the running task that is
-			being suspended. */
-			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+			pxTCB = prvGetTCBFromHandle( xTask );
 
-			traceTASK_SUSPEND( pxTCB );
+			/* The idle task must always be able to run. */
+			configASSERT( pxTCB != xIdleTaskHandle );
 
-			/* Remove task from the ready/delayed list and place in the
-			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			if( prvTaskBudgetDetach( pxTCB ) != pdFALSE )
 			{
-				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				taskYIELD_IF_USING_PREEMPTION();
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			/* Is the task waiting on an event also? */
-			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			if( xBudget != NULL )
 			{
-				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				pxTCB->pxBudget = xBudget;
+				pxTCB->pxNextBudgetTask = xBudget->pxFirstTask;
+				xBudget->pxFirstTask = pxTCB;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-
-			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
-
-			#if( configUSE_TASK_NOTIFICATIONS == 1 )
-			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
-				}
-			}
-			#endif
 		}
 		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
 
-		if( xSchedulerRunning != pdFALSE )
+	TickType_t xTaskBudgetGetRemaining( TaskBudgetHandle_t xBudget )
+	{
+		configASSERT( xBudget );
+
+		return xBudget->xRemaining;
+	}
+
+#endif /* configUSE_TASK_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xThresholdRaised;
+
+		configASSERT( uxThreshold < configMAX_PRIORITIES );
+
+		taskENTER_CRITICAL();
 		{
-			/* Reset the next expected unblock time in case it referred to the
-			task that is now in the Suspended state. */
-			taskENTER_CRITICAL();
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			xThresholdRaised = prvPreemptionThresholdRestore( pxTCB );
+			pxTCB->uxPreemptionThreshold = uxThreshold;
+
+			/* The running task takes the new threshold at once, a lower
+			threshold may let a ready task preempt it.  Before the scheduler
+			starts pxCurrentTCB has not run yet. */
+			if( ( pxTCB == pxCurrentTCB ) && ( xSchedulerRunning != pdFALSE ) )
 			{
-				prvResetNextTaskUnblockTime();
+				prvPreemptionThresholdRaise( pxTCB );
+				taskYIELD_IF_USING_PREEMPTION();
 			}
-			taskEXIT_CRITICAL();
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-
-		if( pxTCB == pxCurrentTCB )
-		{
-			if( xSchedulerRunning != pdFALSE )
+			else if( xThresholdRaised != pdFALSE )
 			{
-				/* The current task has just been suspended. */
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
+				prvPreemptionThresholdRaise( pxTCB );
 			}
 			else
 			{
-				/* The scheduler is not running, but the task that was pointed
-				to by pxCurrentTCB has just been suspended and pxCurrentTCB
-				must be adjusted to point to a different task. */
-				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
-				{
-					/* No other tasks are ready, so set pxCurrentTCB back to
-					NULL so when the next task is created pxCurrentTCB will
-					be set to point to it no matter what its relative priority
-					is. */
-					pxCurrentTCB = NULL;
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxPreemptionThreshold;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_TIME_SLICE == 1 )
+
+	void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xTicks > ( TickType_t ) 0U );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->xTimeSlice = xTicks;
+			pxTCB->xTimeSliceRemaining = xTicks;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_TIME_SLICE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PARTITIONS == 1 )
+
+	void vTaskPartitionScheduleSet( const PartitionWindow_t * const pxWindows, UBaseType_t uxWindowCount )
+	{
+	UBaseType_t uxIndex;
+
+		configASSERT( xSchedulerRunning == pdFALSE );
+		configASSERT( ( pxWindows != NULL ) && ( uxWindowCount > ( UBaseType_t ) 0U ) );
+
+		for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxWindowCount; uxIndex++ )
+		{
+			configASSERT( ( pxWindows[ uxIndex ].uxPartition > ( UBaseType_t ) 0U ) && ( pxWindows[ uxIndex ].uxPartition < ( UBaseType_t ) configNUM_PARTITIONS ) );
+			configASSERT( pxWindows[ uxIndex ].xDuration > ( TickType_t ) 0U );
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxPartitionWindows = pxWindows;
+			uxPartitionWindowCount = uxWindowCount;
+			uxPartitionWindow = ( UBaseType_t ) 0U;
+			uxActivePartition = pxWindows[ 0 ].uxPartition;
+			xPartitionWindowEnd = xTickCount + pxWindows[ 0 ].xDuration;
+
+			/* The tasks created so far could run in any window. */
+			for( uxIndex = ( UBaseType_t ) 1U; uxIndex < ( UBaseType_t ) configNUM_PARTITIONS; uxIndex++ )
+			{
+				if( uxIndex != uxActivePartition )
+				{
+					prvPartitionPark( uxIndex );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* The scheduler starts pxCurrentTCB, make sure it can run. */
+			if( ( pxCurrentTCB != NULL ) && ( taskPARTITION_CAN_RUN( pxCurrentTCB->uxPartition ) == pdFALSE ) )
+			{
+				vTaskSwitchContext();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskSetPartition( TaskHandle_t xTask, UBaseType_t uxPartition )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( uxPartition < ( UBaseType_t ) configNUM_PARTITIONS );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( pxTCB == pxCurrentTCB )
+			{
+				pxTCB->uxPartition = uxPartition;
+
+				/* The running task is parked when it is switched out. */
+				if( taskPARTITION_CAN_RUN( uxPartition ) == pdFALSE )
+				{
+					if( xSchedulerRunning != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						vTaskSwitchContext();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) ||
+					 ( listIS_CONTAINED_WITHIN( &( xPartitionReadyLists[ pxTCB->uxPartition ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				/* A ready task goes to the ready list its new partition
+				allows. */
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB->uxPartition = uxPartition;
+				prvAddTaskToReadyList( pxTCB );
+
+				if( ( taskPARTITION_CAN_RUN( uxPartition ) != pdFALSE ) && ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Blocked and suspended tasks only take the new partition. */
+				pxTCB->uxPartition = uxPartition;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskGetActivePartition( void )
+	{
+		return uxActivePartition;
+	}
+
+#endif /* configUSE_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the running task that is
+			being suspended. */
+			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+			traceTASK_SUSPEND( pxTCB );
+
+			/* Remove task from the ready/delayed list and place in the
+			suspended list. */
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Is the task waiting on an event also? */
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+			#if ( configUSE_TASK_BUDGET == 1 )
+			{
+				/* The replenishment of the budget must not resume a task
+				that is now suspended explicitly. */
+				if( pxTCB->ucBudgetState == taskBUDGET_SUSPENDED )
+				{
+					pxTCB->ucBudgetState = taskBUDGET_NOT_THROTTLED;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			{
+			UBaseType_t uxIndex;
+
+				for( uxIndex = 0U; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+				{
+					if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but is
+						now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ uxIndex ] = taskNOT_WAITING_NOTIFICATION;
+					}
+				}
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* Reset the next expected unblock time in case it referred to the
+			task that is now in the Suspended state. */
+			taskENTER_CRITICAL();
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxTCB == pxCurrentTCB )
+		{
+			if( xSchedulerRunning != pdFALSE )
+			{
+				/* The current task has just been suspended. */
+				configASSERT( uxSchedulerSuspended == 0 );
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				/* The scheduler is not running, but the task that was pointed
+				to by pxCurrentTCB has just been suspended and pxCurrentTCB
+				must be adjusted to point to a different task. */
+				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+				{
+					/* No other tasks are ready, so set pxCurrentTCB back to
+					NULL so when the next task is created pxCurrentTCB will
+					be set to point to it no matter what its relative priority
+					is. */
+					pxCurrentTCB = NULL;
 				}
 				else
 				{
@@ -1901,7 +2930,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB->uxPriority ) )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1969,7 +2998,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB->uxPriority ) )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -2157,7 +3186,15 @@ void vTaskSuspendAll( void )
 		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
 		task that are in the Ready state, even though the idle task is
 		running. */
-		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		#if( configUSE_PRIORITY_BITMAP_TASK_SELECTION == 1 )
+		{
+			/* Any ready bit other than the one of the idle priority. */
+			if( ( ulReadyGroups > 1UL ) || ( ulReadyPriorities[ 0 ] > 1UL ) )
+			{
+				uxHigherPriorityReadyTasks = pdTRUE;
+			}
+		}
+		#elif( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 		{
 			if( uxTopReadyPriority > tskIDLE_PRIORITY )
 			{
@@ -2242,7 +3279,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB->uxPriority ) )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2483,6 +3520,16 @@ TCB_t *pxTCB;
 
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+			#if ( configUSE_PARTITIONS == 1 )
+			{
+				/* Search the ready lists of the partitions. */
+				for( uxQueue = ( UBaseType_t ) 0U; ( pxTCB == NULL ) && ( uxQueue < ( UBaseType_t ) configNUM_PARTITIONS ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xPartitionReadyLists[ uxQueue ] ), pcNameToQuery );
+				}
+			}
+			#endif
+
 			/* Search the delayed lists. */
 			if( pxTCB == NULL )
 			{
@@ -2542,6 +3589,16 @@ TCB_t *pxTCB;
 
 				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+				#if ( configUSE_PARTITIONS == 1 )
+				{
+					/* Ready tasks of the partitions outside their window. */
+					for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configNUM_PARTITIONS; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xPartitionReadyLists[ uxQueue ] ), eReady );
+					}
+				}
+				#endif
+
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
@@ -2678,7 +3735,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2801,7 +3858,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( taskTICK_UNBLOCK_PREEMPTS( pxTCB->uxPriority ) )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2815,12 +3872,46 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		#if ( configUSE_PARTITIONS == 1 )
+		{
+			/* The window has ended once the tick count is at or past its end,
+			compared as a difference so it is overflow safe. */
+			if( ( pxPartitionWindows != NULL ) && ( ( TickType_t ) ( xConstTickCount - xPartitionWindowEnd ) <= ( portMAX_DELAY >> 1 ) ) )
+			{
+				prvPartitionNextWindow();
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PARTITIONS */
+
+		#if ( configUSE_TASK_BUDGET == 1 )
+		{
+			if( prvTaskBudgetTick( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGET */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			/* The quantum is only consumed while another task of the same
+			priority is waiting for it. */
+			if( ( taskIS_TIME_SLICED( pxCurrentTCB->uxPriority ) != pdFALSE ) &&
+				( taskTHRESHOLD_RAISED() == pdFALSE ) &&
+				( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+				( taskTIME_SLICE_USED() != pdFALSE ) )
 			{
 				xSwitchRequired = pdTRUE;
 			}
@@ -3039,12 +4130,83 @@ void vTaskSwitchContext( void )
 		}
 		#endif
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		traceTASK_SWITCHED_IN();
-
-		/* After the new task is switched in, update the global errno. */
+		#if ( configUSE_PARTITIONS == 1 )
+		{
+			/* The running task of a window that has closed leaves the ready
+			lists now. */
+			if( ( taskPARTITION_CAN_RUN( pxCurrentTCB->uxPartition ) == pdFALSE ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				prvPartitionParkTask( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			/* A task that left the Ready state gives up its preemption
+			threshold, a preempted task keeps it. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE )
+			{
+				( void ) prvPreemptionThresholdRestore( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		/* Select a new task to run using either the generic C or port
+		optimised asm code. */
+		#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			if( prvPreemptionThresholdSelect() == pdFALSE )
+			{
+				taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		#endif
+
+		#if ( ( configUSE_PARTITIONS == 1 ) && ( configPARTITION_BACKGROUND != 0 ) )
+		{
+			/* The window owner has nothing to run, give the time to the
+			background partition. */
+			if( ( pxCurrentTCB == xIdleTaskHandle ) && ( xPartitionDonated == pdFALSE ) && ( pxPartitionWindows != NULL ) &&
+				( listLIST_IS_EMPTY( &( xPartitionReadyLists[ configPARTITION_BACKGROUND ] ) ) == pdFALSE ) )
+			{
+				xPartitionDonated = pdTRUE;
+				prvPartitionUnpark( configPARTITION_BACKGROUND );
+				taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			prvPreemptionThresholdRaise( pxCurrentTCB );
+		}
+		#endif
+
+		traceTASK_SWITCHED_IN();
+
+		/* After the new task is switched in, update the global errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
 			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
@@ -3184,7 +4346,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( ( pxUnblockedTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3227,7 +4389,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( ( pxUnblockedTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3238,6 +4400,189 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configEVENT_GROUP_ISR_MAX_WAITERS > 0 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED.  The event group
+		is locked against tasks, but the scheduler need not be suspended. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed. */
+			vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		}
+
+		if( ( pxUnblockedTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxUnblockedTCB ) )
+		{
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configEVENT_GROUP_ISR_MAX_WAITERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_HANDOFF == 1 )
+
+	void vTaskSetHandoffBuffer( void * const pvBuffer )
+	{
+		/* Called with the scheduler suspended, just before the calling task
+		is placed on an event list. */
+		pxCurrentTCB->pvHandoffBuffer = pvBuffer;
+	}
+
+#endif /* configUSE_QUEUE_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_HANDOFF == 1 )
+
+	void *pvTaskTakeHandoffBuffer( const List_t * const pxEventList )
+	{
+	TCB_t *pxWaitingTCB;
+	void *pvReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED.  The task at the
+		head of the list is the one xTaskRemoveFromEventList() unblocks, so only
+		its buffer can be used. */
+		pxWaitingTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		pvReturn = pxWaitingTCB->pvHandoffBuffer;
+
+		/* The task finds the buffer gone when it runs again, and so knows the
+		item was copied to it. */
+		pxWaitingTCB->pvHandoffBuffer = NULL;
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_QUEUE_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_HANDOFF == 1 )
+
+	BaseType_t xTaskHandoffCompleted( void )
+	{
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxCurrentTCB->pvHandoffBuffer == NULL )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				/* Unblocked by a timeout, or because the item went through the
+				queue storage area. */
+				pxCurrentTCB->pvHandoffBuffer = NULL;
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	void vTaskMoveToMutexEventList( const List_t * const pxFromEventList, void * const pvMutex, List_t * const pxMutexEventList, TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t *pxMovedTCB;
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED AND THE
+		MUTEX LOCKED.  The tick interrupt cannot time the task out while the
+		scheduler is suspended, and interrupts do not access the event list of
+		a locked queue. */
+		configASSERT( uxSchedulerSuspended != 0 );
+
+		pxMovedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxFromEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxMovedTCB );
+
+		/* The task stays on the delayed list, so it still times out when its
+		original block time expires.  The event list item value holds its
+		priority, so the item goes in priority order on the new list too. */
+		( void ) uxListRemove( &( pxMovedTCB->xEventListItem ) );
+		vListInsert( pxMutexEventList, &( pxMovedTCB->xEventListItem ) );
+		pxMovedTCB->ucMovedToMutex = pdTRUE;
+
+		/* The holder inherits from the moved task as it would have had the
+		task blocked in xSemaphoreTake() itself.  Interrupts can still make
+		tasks ready, so the ready lists are only changed in a critical
+		section. */
+		taskENTER_CRITICAL();
+		{
+			#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+			{
+				/* The moved task is on the event list of the mutex already, so
+				the holder picks up its priority from there. */
+				pxMovedTCB->pvMutexBlockedOn = pvMutex;
+				prvMutexPropagate( pxMutexHolder, tskIDLE_PRIORITY );
+			}
+			#else
+			{
+				( void ) pvMutex;
+
+				if( pxMutexHolder != NULL )
+				{
+					( void ) prvTaskPriorityInherit( pxMutexHolder, pxMovedTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskMovedToMutex( void )
+	{
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			xReturn = ( BaseType_t ) pxCurrentTCB->ucMovedToMutex;
+			pxCurrentTCB->ucMovedToMutex = pdFALSE;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3395,6 +4740,16 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		is responsible for freeing the deleted task's TCB and stack. */
 		prvCheckTasksWaitingTermination();
 
+#ifdef CONFIG_HEAP_PREFILL_POOL
+		/* Fill one slice of the heap pre-filled block pool. */
+		vPortPrefillPoolStep();
+#endif
+
+#ifdef CONFIG_MEMORY_ERROR_DETECTION_IDLE_CHECK
+		/* Check a bounded number of heap blocks for corruption. */
+		( void ) xPortCheckIntegrityStep( CONFIG_MEMORY_ERROR_DETECTION_IDLE_CHECK_BUDGET );
+#endif
+
 		#if ( configUSE_PREEMPTION == 0 )
 		{
 			/* If we are not using preemption we keep forcing a task switch to
@@ -3613,6 +4968,15 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if ( configUSE_PARTITIONS == 1 )
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configNUM_PARTITIONS; uxPriority++ )
+		{
+			vListInitialise( &( xPartitionReadyLists[ uxPriority ] ) );
+		}
+	}
+	#endif /* configUSE_PARTITIONS */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3944,7 +5308,784 @@ TCB_t *pxTCB;
 		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
-}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static BaseType_t prvEdfDeadlineBefore( const TCB_t * const pxTCB, const TCB_t * const pxOtherTCB )
+	{
+	BaseType_t xReturn;
+
+		if( pxTCB->xEdfPeriod == 0U )
+		{
+			xReturn = ( pxOtherTCB->xEdfPeriod != 0U ) ? pdTRUE : pdFALSE;
+		}
+		else if( pxOtherTCB->xEdfPeriod == 0U )
+		{
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			/* Deadlines are never more than half the tick range apart, so the
+			difference tells the order even across a tick count overflow. */
+			xReturn = ( ( TickType_t ) ( pxTCB->xEdfAbsoluteDeadline - pxOtherTCB->xEdfAbsoluteDeadline ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvEdfInsertReady( TCB_t * const pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Tasks with the same deadline keep their arrival order.  Item values
+		cannot be used as they do not survive a tick count overflow. */
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( prvEdfDeadlineBefore( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxNext ) ) != pdFALSE )
+			{
+				break;
+			}
+		}
+
+		/* Same as the insertion in vListInsert(). */
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+		( pxList->uxNumberOfItems )++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvEdfUtilisation( const TickType_t xBudget, const TickType_t xRelativeDeadline )
+	{
+		return ( uint32_t ) ( ( ( ( uint64_t ) xBudget * taskEDF_FULL_UTILISATION ) + xRelativeDeadline - 1U ) / xRelativeDeadline );
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGET == 1 )
+
+	static BaseType_t prvTaskBudgetTick( const TickType_t xConstTickCount )
+	{
+	TaskBudget_t *pxBudget = pxCurrentTCB->pxBudget;
+	TCB_t *pxTCB;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* The running task used the tick that just ended.  A demoted task
+		runs on borrowed time and is not charged. */
+		if( ( pxBudget != NULL ) && ( pxCurrentTCB->ucBudgetState != taskBUDGET_DEMOTED ) )
+		{
+			if( pxBudget->xRemaining > ( TickType_t ) 0U )
+			{
+				pxBudget->xRemaining--;
+
+				if( ( pxBudget->xRemaining == ( TickType_t ) 0U ) && ( pxBudget->pxOverrunHook != NULL ) )
+				{
+					pxBudget->pxOverrunHook( pxCurrentTCB, pxBudget );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A task that is blocking already is throttled the next time it
+			runs, as is any other task sharing the exhausted budget. */
+			if( ( pxBudget->xRemaining == ( TickType_t ) 0U ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				prvTaskBudgetThrottle( pxCurrentTCB );
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxBudget = pxTaskBudgets; pxBudget != NULL; pxBudget = pxBudget->pxNextBudget )
+		{
+			/* The period has ended once the tick count is at or past its end,
+			compared as a difference so it is overflow safe and a period end
+			that was not seen exactly is still acted on. */
+			if( ( TickType_t ) ( xConstTickCount - pxBudget->xNextReplenish ) <= ( portMAX_DELAY >> 1 ) )
+			{
+				pxBudget->xNextReplenish += pxBudget->xPeriod;
+				pxBudget->xRemaining = pxBudget->xBudget;
+
+				for( pxTCB = pxBudget->pxFirstTask; pxTCB != NULL; pxTCB = pxTCB->pxNextBudgetTask )
+				{
+					if( prvTaskBudgetRelease( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xSwitchRequired;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTaskBudgetThrottle( TCB_t * const pxTCB )
+	{
+		#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			/* A throttled task gives up its preemption threshold. */
+			( void ) prvPreemptionThresholdRestore( pxTCB );
+		}
+		#endif
+
+		if( pxTCB->pxBudget->eAction == eTaskBudgetDemote )
+		{
+			/* Nothing to do for a task already at the background priority. */
+			if( pxTCB->uxPriority > ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY )
+			{
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB->uxBudgetPriority = pxTCB->uxPriority;
+				pxTCB->uxPriority = ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY;
+
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxTCB );
+				pxTCB->ucBudgetState = taskBUDGET_DEMOTED;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		else
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+			pxTCB->ucBudgetState = taskBUDGET_SUSPENDED;
+		}
+		#endif
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTaskBudgetRelease( TCB_t * const pxTCB )
+	{
+	BaseType_t xPreempt = pdFALSE;
+	UBaseType_t uxPriorityUsedOnEntry;
+
+		if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
+		{
+			/* Keep the priority if the task inherited a higher one since the
+			demotion. */
+			if( pxTCB->uxPriority < pxTCB->uxBudgetPriority )
+			{
+				uxPriorityUsedOnEntry = pxTCB->uxPriority;
+				pxTCB->uxPriority = pxTCB->uxBudgetPriority;
+
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Blocked and suspended tasks only need the priority change. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+					prvAddTaskToReadyList( pxTCB );
+
+					if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
+					{
+						xPreempt = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		else if( pxTCB->ucBudgetState == taskBUDGET_SUSPENDED )
+		{
+			/* Leave the task alone if it was resumed meanwhile, or if an
+			interrupt placed it in the pending ready list. */
+			if( ( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+				( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) ) /*lint !e961.  The cast is only redundant when NULL is used. */
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
+				{
+					xPreempt = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->ucBudgetState = taskBUDGET_NOT_THROTTLED;
+
+		return xPreempt;
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvTaskBudgetClampPriority( TCB_t * const pxTCB, UBaseType_t uxPriority )
+	{
+		if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
+		{
+			pxTCB->uxBudgetPriority = uxPriority;
+
+			if( uxPriority > ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY )
+			{
+				uxPriority = ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxPriority;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTaskBudgetDetach( TCB_t * const pxTCB )
+	{
+	TCB_t **ppxLink;
+	BaseType_t xPreempt = pdFALSE;
+
+		if( pxTCB->pxBudget != NULL )
+		{
+			xPreempt = prvTaskBudgetRelease( pxTCB );
+
+			for( ppxLink = &( pxTCB->pxBudget->pxFirstTask ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextBudgetTask ) )
+			{
+				if( *ppxLink == pxTCB )
+				{
+					*ppxLink = pxTCB->pxNextBudgetTask;
+					break;
+				}
+			}
+
+			pxTCB->pxBudget = NULL;
+			pxTCB->pxNextBudgetTask = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xPreempt;
+	}
+
+#endif /* configUSE_TASK_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	static void prvPreemptionThresholdRaise( TCB_t * const pxTCB )
+	{
+		if( ( pxTCB->ucThresholdRaised == pdFALSE ) && ( pxTCB->uxPreemptionThreshold > pxTCB->uxPriority ) )
+		{
+			pxTCB->ucThresholdRaised = pdTRUE;
+			pxTCB->pxNextThresholdRaised = pxThresholdRaisedTasks;
+			pxThresholdRaisedTasks = pxTCB;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvPreemptionThresholdRestore( TCB_t * const pxTCB )
+	{
+	TCB_t **ppxLink;
+	BaseType_t xWasRaised = pdFALSE;
+
+		if( pxTCB->ucThresholdRaised != pdFALSE )
+		{
+			for( ppxLink = &pxThresholdRaisedTasks; *ppxLink != pxTCB; ppxLink = &( ( *ppxLink )->pxNextThresholdRaised ) )
+			{
+				configASSERT( *ppxLink );
+			}
+
+			*ppxLink = pxTCB->pxNextThresholdRaised;
+			pxTCB->pxNextThresholdRaised = NULL;
+			pxTCB->ucThresholdRaised = pdFALSE;
+			xWasRaised = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xWasRaised;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvPreemptionThresholdSelect( void )
+	{
+	TCB_t *pxTCB, *pxNextTCB;
+	TCB_t *pxSelectedTCB = NULL;
+	UBaseType_t uxThreshold = tskIDLE_PRIORITY, uxTopPriority;
+	BaseType_t xSelected = pdFALSE;
+
+		for( pxTCB = pxThresholdRaisedTasks; pxTCB != NULL; pxTCB = pxNextTCB )
+		{
+			pxNextTCB = pxTCB->pxNextThresholdRaised;
+
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) == pdFALSE )
+			{
+				/* A preempted task that was suspended or parked gives up its
+				threshold. */
+				( void ) prvPreemptionThresholdRestore( pxTCB );
+			}
+			else if( ( pxSelectedTCB == NULL ) || ( taskTHRESHOLD_PRIORITY( pxTCB ) > uxThreshold ) )
+			{
+				pxSelectedTCB = pxTCB;
+				uxThreshold = taskTHRESHOLD_PRIORITY( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxSelectedTCB != NULL )
+		{
+			taskFIND_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+			if( uxTopPriority <= uxThreshold )
+			{
+				pxCurrentTCB = pxSelectedTCB;
+				xSelected = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSelected;
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_TIME_SLICE == 1 )
+
+	static BaseType_t prvTimeSliceUsed( void )
+	{
+	BaseType_t xUsed = pdFALSE;
+
+		if( pxCurrentTCB->xTimeSliceRemaining > ( TickType_t ) 1U )
+		{
+			( pxCurrentTCB->xTimeSliceRemaining )--;
+		}
+		else
+		{
+			pxCurrentTCB->xTimeSliceRemaining = pxCurrentTCB->xTimeSlice;
+			xUsed = pdTRUE;
+		}
+
+		return xUsed;
+	}
+
+#endif /* configUSE_TASK_TIME_SLICE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PARTITIONS == 1 )
+
+	static void prvPartitionAddToReadyList( TCB_t * const pxTCB )
+	{
+		if( taskPARTITION_CAN_RUN( pxTCB->uxPartition ) != pdFALSE )
+		{
+			#if ( configPARTITION_BACKGROUND != 0 )
+			{
+				/* The window owner has work again, take back the time given to
+				the background partition.  A running background task is
+				switched out by the next tick at the latest. */
+				if( ( xPartitionDonated != pdFALSE ) && ( pxTCB->uxPartition == uxActivePartition ) )
+				{
+					xPartitionDonated = pdFALSE;
+					prvPartitionPark( configPARTITION_BACKGROUND );
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			taskADD_TO_READY_LIST( pxTCB );
+		}
+		else
+		{
+			vListInsertEnd( &( xPartitionReadyLists[ pxTCB->uxPartition ] ), &( pxTCB->xStateListItem ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPartitionParkTask( TCB_t * const pxTCB )
+	{
+		if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+		{
+			portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vListInsertEnd( &( xPartitionReadyLists[ pxTCB->uxPartition ] ), &( pxTCB->xStateListItem ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPartitionPark( const UBaseType_t uxPartition )
+	{
+	UBaseType_t uxPriority;
+	ListItem_t *pxIterator;
+	TCB_t *pxTCB;
+
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+		{
+			pxIterator = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxPriority ] ) );
+
+			while( pxIterator != listGET_END_MARKER( &( pxReadyTasksLists[ uxPriority ] ) ) )
+			{
+				pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				pxIterator = listGET_NEXT( pxIterator );
+
+				if( ( pxTCB->uxPartition == uxPartition ) && ( pxTCB != pxCurrentTCB ) )
+				{
+					prvPartitionParkTask( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPartitionUnpark( const UBaseType_t uxPartition )
+	{
+	TCB_t *pxTCB;
+
+		while( listLIST_IS_EMPTY( &( xPartitionReadyLists[ uxPartition ] ) ) == pdFALSE )
+		{
+			pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &( xPartitionReadyLists[ uxPartition ] ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			taskADD_TO_READY_LIST( pxTCB );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPartitionNextWindow( void )
+	{
+	const UBaseType_t uxPreviousPartition = uxActivePartition;
+
+		#if ( configPARTITION_BACKGROUND != 0 )
+		{
+			/* Idle time is only given for the window it belongs to. */
+			if( xPartitionDonated != pdFALSE )
+			{
+				xPartitionDonated = pdFALSE;
+				prvPartitionPark( configPARTITION_BACKGROUND );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		uxPartitionWindow++;
+
+		if( uxPartitionWindow >= uxPartitionWindowCount )
+		{
+			uxPartitionWindow = ( UBaseType_t ) 0U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxActivePartition = pxPartitionWindows[ uxPartitionWindow ].uxPartition;
+		xPartitionWindowEnd += pxPartitionWindows[ uxPartitionWindow ].xDuration;
+
+		if( uxActivePartition != uxPreviousPartition )
+		{
+			prvPartitionPark( uxPreviousPartition );
+			prvPartitionUnpark( uxActivePartition );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+	static BaseType_t prvMutexUpdatePriority( TCB_t * const pxTCB, const UBaseType_t uxFloor )
+	{
+	UBaseType_t uxPriority, uxMutexPriority, uxPriorityUsedOnEntry;
+	const ListItem_t *pxIterator;
+	List_t *pxEventList;
+	BaseType_t xChanged = pdFALSE;
+
+		uxPriority = taskBUDGET_CLAMP_PRIORITY( pxTCB, pxTCB->uxBasePriority );
+
+		if( uxPriority < uxFloor )
+		{
+			uxPriority = uxFloor;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxIterator = listGET_HEAD_ENTRY( &( pxTCB->xMutexesHeld ) ); pxIterator != listGET_END_MARKER( &( pxTCB->xMutexesHeld ) ); pxIterator = listGET_NEXT( pxIterator ) )
+		{
+			uxMutexPriority = uxQueueGetMutexWaitingPriority( ( QueueHandle_t ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+			if( uxPriority < uxMutexPriority )
+			{
+				uxPriority = uxMutexPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxTCB->uxPriority != uxPriority )
+		{
+			uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+			if( uxPriority > uxPriorityUsedOnEntry )
+			{
+				traceTASK_PRIORITY_INHERIT( pxTCB, uxPriority );
+			}
+			else
+			{
+				traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriority );
+			}
+
+			pxTCB->uxPriority = uxPriority;
+
+			/* Only reset the event list item value if the value is not being
+			used for anything else. */
+			if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				/* The waiters of a mutex are ordered by priority, and the
+				holder inherits from the head of the list. */
+				pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+				if( ( pxTCB->pvMutexBlockedOn != NULL ) && ( pxEventList != NULL ) )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xChanged = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xChanged;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvMutexPropagate( TCB_t *pxTCB, UBaseType_t uxFloor )
+	{
+		/* Priorities only move one way along a walk, so the walk also ends
+		if the waiting tasks form a cycle (a deadlock). */
+		while( pxTCB != NULL )
+		{
+			if( prvMutexUpdatePriority( pxTCB, uxFloor ) != pdFALSE )
+			{
+				/* A task removed from the event list by a timeout, delete or
+				suspend no longer waits, whatever pvMutexBlockedOn says. */
+				if( ( pxTCB->pvMutexBlockedOn != NULL ) && ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL ) )
+				{
+					pxTCB = xQueueGetMutexHolder( ( QueueHandle_t ) pxTCB->pvMutexBlockedOn );
+				}
+				else
+				{
+					pxTCB = NULL;
+				}
+
+				/* The next holder picks up the new priority from its
+				waiters. */
+				uxFloor = tskIDLE_PRIORITY;
+			}
+			else
+			{
+				pxTCB = NULL;
+			}
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#ifdef taskUSE_GENERIC_COUNT_LEADING_ZEROS
+
+	static UBaseType_t prvCountLeadingZeros32( uint32_t ulValue )
+	{
+	UBaseType_t uxZeros = 0;
+
+		/* Binary search, the same five steps for every value. */
+		if( ( ulValue & 0xffff0000UL ) == 0UL )
+		{
+			uxZeros += 16;
+			ulValue <<= 16;
+		}
+		if( ( ulValue & 0xff000000UL ) == 0UL )
+		{
+			uxZeros += 8;
+			ulValue <<= 8;
+		}
+		if( ( ulValue & 0xf0000000UL ) == 0UL )
+		{
+			uxZeros += 4;
+			ulValue <<= 4;
+		}
+		if( ( ulValue & 0xc0000000UL ) == 0UL )
+		{
+			uxZeros += 2;
+			ulValue <<= 2;
+		}
+		if( ( ulValue & 0x80000000UL ) == 0UL )
+		{
+			uxZeros += 1;
+		}
+
+		return uxZeros;
+	}
+
+#endif /* taskUSE_GENERIC_COUNT_LEADING_ZEROS */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -3996,7 +6137,6 @@ TCB_t *pxTCB;
 
 	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
 	{
-	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
 	BaseType_t xReturn = pdFALSE;
 
 		/* If the mutex was given back by an interrupt while the queue was
@@ -4004,73 +6144,83 @@ TCB_t *pxTCB;
 		needed as interrupts can no longer use mutexes? */
 		if( pxMutexHolder != NULL )
 		{
-			/* If the holder of the mutex has a priority below the priority of
-			the task attempting to obtain the mutex then it will temporarily
-			inherit the priority of the task attempting to obtain the mutex. */
-			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
-			{
-				/* Adjust the mutex holder state to account for its new
-				priority.  Only reset the event list item value if the value is
-				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* If the task being modified is in the ready state it will need
-				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-					{
-						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+			xReturn = prvTaskPriorityInherit( pxMutexHolder, pxCurrentTCB->uxPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxMutexHolderTCB );
-				}
-				else
-				{
-					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-				}
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
 
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+	static BaseType_t prvTaskPriorityInherit( TCB_t * const pxMutexHolderTCB, const UBaseType_t uxInheritedPriority )
+	{
+	BaseType_t xReturn = pdFALSE;
 
-				/* Inheritance occurred. */
-				xReturn = pdTRUE;
+		/* If the holder of the mutex has a priority below the priority of
+		the task attempting to obtain the mutex then it will temporarily
+		inherit the priority of the task attempting to obtain the mutex. */
+		if( pxMutexHolderTCB->uxPriority < uxInheritedPriority )
+		{
+			/* Adjust the mutex holder state to account for its new
+			priority.  Only reset the event list item value if the value is
+			not being used for anything else. */
+			if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxInheritedPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 			}
 			else
 			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* If the task being modified is in the ready state it will need
+			to be moved into a new list. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+			{
+				if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 				{
-					/* The base priority of the mutex holder is lower than the
-					priority of the task attempting to take the mutex, but the
-					current priority of the mutex holder is not lower than the
-					priority of the task attempting to take the mutex.
-					Therefore the mutex holder must have already inherited a
-					priority, but inheritance would have occurred if that had
-					not been the case. */
-					xReturn = pdTRUE;
+					taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				/* Inherit the priority before being moved into the new list. */
+				pxMutexHolderTCB->uxPriority = uxInheritedPriority;
+				prvAddTaskToReadyList( pxMutexHolderTCB );
+			}
+			else
+			{
+				/* Just inherit the priority. */
+				pxMutexHolderTCB->uxPriority = uxInheritedPriority;
 			}
+
+			traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, uxInheritedPriority );
+
+			/* Inheritance occurred. */
+			xReturn = pdTRUE;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			if( pxMutexHolderTCB->uxBasePriority < uxInheritedPriority )
+			{
+				/* The base priority of the mutex holder is lower than the
+				priority of the task attempting to take the mutex, but the
+				current priority of the mutex holder is not lower than the
+				priority of the task attempting to take the mutex.
+				Therefore the mutex holder must have already inherited a
+				priority, but inheritance would have occurred if that had
+				not been the case. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 
 		return xReturn;
@@ -4120,7 +6270,7 @@ TCB_t *pxTCB;
 					/* Disinherit the priority before adding the task into the
 					new	ready list. */
 					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					pxTCB->uxPriority = pxTCB->uxBasePriority;
+					pxTCB->uxPriority = taskBUDGET_CLAMP_PRIORITY( pxTCB, pxTCB->uxBasePriority );
 
 					/* Reset the event list item value.  It cannot be in use for
 					any other purpose if this task is running, and it must be
@@ -4176,14 +6326,17 @@ TCB_t *pxTCB;
 			/* Determine the priority to which the priority of the task that
 			holds the mutex should be set.  This will be the greater of the
 			holding task's base priority and the priority of the highest
-			priority task that is waiting to obtain the mutex. */
-			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+			priority task that is waiting to obtain the mutex.  A demoted task
+			uses the background priority in place of its base priority. */
+			uxPriorityToUse = taskBUDGET_CLAMP_PRIORITY( pxTCB, pxTCB->uxBasePriority );
+
+			if( uxPriorityToUse < uxHighestPriorityWaitingTask )
 			{
 				uxPriorityToUse = uxHighestPriorityWaitingTask;
 			}
 			else
 			{
-				uxPriorityToUse = pxTCB->uxBasePriority;
+				mtCOVERAGE_TEST_MARKER();
 			}
 
 			/* Does the priority need to change? */
@@ -4619,19 +6772,174 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskDecrementMutexHeldCount( void )
+	{
+	BaseType_t xDisinheritRequired = pdFALSE;
+
+		/* Only the running task changes its own count. */
+		configASSERT( pxCurrentTCB->uxMutexesHeld );
+
+		if( ( pxCurrentTCB->uxMutexesHeld == ( UBaseType_t ) 1 ) && ( pxCurrentTCB->uxPriority != pxCurrentTCB->uxBasePriority ) )
+		{
+			xDisinheritRequired = pdTRUE;
+		}
+		else
+		{
+			( pxCurrentTCB->uxMutexesHeld )--;
+		}
+
+		return xDisinheritRequired;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+	void vTaskPriorityCeilingRaise( UBaseType_t uxCeilingPriority )
+	{
+		/* Called from a critical section by the task that has just taken the
+		mutex, which is pxCurrentTCB.  The priority only goes up, so no
+		context switch is needed. */
+		if( pxCurrentTCB != NULL )
+		{
+			if( pxCurrentTCB->uxPriority < uxCeilingPriority )
+			{
+				if( ( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Before the scheduler has started pxCurrentTCB is not
+				necessarily in a ready list. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxCurrentTCB->uxPriority = uxCeilingPriority;
+					prvAddTaskToReadyList( pxCurrentTCB );
+				}
+				else
+				{
+					pxCurrentTCB->uxPriority = uxCeilingPriority;
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeilingPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+	TaskHandle_t pvTaskMutexTaken( ListItem_t * const pxMutexHeldListItem )
+	{
+		/* If the mutex is taken before any tasks have been created then
+		pxCurrentTCB will be NULL. */
+		if( pxCurrentTCB != NULL )
+		{
+			( pxCurrentTCB->uxMutexesHeld )++;
+			pxCurrentTCB->pvMutexBlockedOn = NULL;
+			vListInsertEnd( &( pxCurrentTCB->xMutexesHeld ), pxMutexHeldListItem );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxCurrentTCB;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskMutexInherit( void * const pvMutex, TaskHandle_t const pxMutexHolder )
+	{
+		/* Called from a critical section by the task that is about to block
+		on pvMutex. */
+		pxCurrentTCB->pvMutexBlockedOn = pvMutex;
+
+		/* The calling task is not in the event list of the mutex yet, so
+		the first holder is given its priority explicitly. */
+		prvMutexPropagate( pxMutexHolder, pxCurrentTCB->uxPriority );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskMutexDisinherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* A mutex can only be given by the running task, which has
+			already removed the mutex from its list of held mutexes. */
+			configASSERT( pxTCB == pxCurrentTCB );
+			configASSERT( pxTCB->uxMutexesHeld );
+			( pxTCB->uxMutexesHeld )--;
+
+			/* Unlike xTaskPriorityDisinherit() the priority is recomputed
+			from the mutexes still held, so mutexes can be given in any
+			order.  The running task is not waiting for a mutex, so there is
+			no chain to follow. */
+			xReturn = prvMutexUpdatePriority( pxTCB, tskIDLE_PRIORITY );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskMutexDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder )
+	{
+		/* The calling task has already been removed from the event list of
+		the mutex, so it no longer counts towards the holder's priority. */
+		pxCurrentTCB->pvMutexBlockedOn = NULL;
+		prvMutexPropagate( pxMutexHolder, tskIDLE_PRIORITY );
+	}
+
+#endif /* configUSE_TRANSITIVE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4659,17 +6967,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4677,7 +6985,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4689,22 +6997,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4737,14 +7047,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4753,11 +7063,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4769,44 +7079,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4824,7 +7135,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0U );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0U );
 
 					break;
 			}
@@ -4857,7 +7168,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4872,6 +7183,26 @@ TickType_t uxReturn;
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				if( ( pxTCB->xPollMember != NULL ) && ( uxIndexToNotify == tskDEFAULT_INDEX_TO_NOTIFY ) )
+				{
+					if( xPollSetSignal( pxTCB->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
 		}
 		taskEXIT_CRITICAL();
 
@@ -4883,7 +7214,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4891,6 +7222,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4916,30 +7248,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4957,7 +7289,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0U );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0U );
 					break;
 			}
 
@@ -4982,7 +7314,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5001,6 +7333,26 @@ TickType_t uxReturn;
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				if( ( pxTCB->xPollMember != NULL ) && ( uxIndexToNotify == tskDEFAULT_INDEX_TO_NOTIFY ) )
+				{
+					if( ( xPollSetSignal( pxTCB->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
 		}
 		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -5012,13 +7364,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -5042,12 +7395,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -5070,7 +7423,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( ( pxTCB->uxPriority > taskRUNNING_PRIORITY() ) || taskEDF_PREEMPTS( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5089,6 +7442,26 @@ TickType_t uxReturn;
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+
+			#if ( configUSE_POLL_SETS == 1 )
+			{
+				if( ( pxTCB->xPollMember != NULL ) && ( uxIndexToNotify == tskDEFAULT_INDEX_TO_NOTIFY ) )
+				{
+					if( ( xPollSetSignal( pxTCB->xPollMember, pollOBJECT_WRITTEN ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_POLL_SETS */
 		}
 		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
@@ -5099,20 +7472,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -5128,6 +7503,51 @@ TickType_t uxReturn;
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_POLL_SETS == 1 ) )
+
+	BaseType_t xTaskSetPollMember( TaskHandle_t xTask, PollMemberHandle_t xMember )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( xMember != NULL ) && ( pxTCB->xPollMember != NULL ) )
+			{
+				/* Cannot add a task to more than one poll set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxTCB->xPollMember = xMember;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_POLL_SETS == 1 ) )
+
+	BaseType_t xTaskNotifyStatePending( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* A single byte read, no critical section needed. */
+		return ( pxTCB->ucNotifyState[ tskDEFAULT_INDEX_TO_NOTIFY ] == taskNOTIFICATION_RECEIVED ) ? pdTRUE : pdFALSE;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
+
 #if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 	TickType_t xTaskGetIdleRunTimeCounter( void )
 	{
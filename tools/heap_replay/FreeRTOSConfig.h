@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Host configuration for heap_replay, only the heap is built. */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION 1
+#define configUSE_IDLE_HOOK 0
+#define configUSE_TICK_HOOK 0
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 8
+#define configMINIMAL_STACK_SIZE 256
+#define configMAX_TASK_NAME_LEN 16
+#define configUSE_16_BIT_TICKS 0
+#define configUSE_MUTEXES 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1
+
+#define configASSERT(x)                                                                            \
+	do {                                                                                       \
+		if (!(x))                                                                          \
+			abort();                                                                   \
+	} while (0)
+
+/* heap_5: regions are set by heap_replay, the default one is never used */
+#define CONFIG_RISCV 1
+#define configDEFAULT_HEAP_ADDR 0
+#define configDEFAULT_HEAP_SIZE 0
+
+/* heap_4 and other single region allocators */
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE (4 * 1024 * 1024)
+#endif
+
+#endif
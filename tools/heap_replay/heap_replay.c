@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Replay a heap allocation trace (CONFIG_HEAP_ALLOC_TRACE) on a Linux host
+ * against heap_5.c, and report peak footprint, fragmentation and latency
+ * percentiles.
+ *
+ * Build from the kernel root:
+ *   gcc -O2 -Itools/heap_replay -Iinclude -Iaml_extend \
+ *       tools/heap_replay/heap_replay.c -o heap_replay
+ * Add -m32 for 32 bit targets, so block headers have the target size.
+ * The trace keeps 32 bit addresses, see struct alloc_trace_record.
+ * Another allocator with the pvPortMalloc()/vPortFree() interface can be
+ * built in with -DHEAP_REPLAY_ALLOCATOR='"path/to/heap.c"', it is then
+ * given a single region of configTOTAL_HEAP_SIZE bytes.
+ *
+ * Usage:
+ *   heap_replay [-r size[,size...]] trace
+ * The trace is either the console log holding the vPortAllocTraceDump()
+ * output or a raw memory dump of the trace buffer. -r sets the heap region
+ * layout, by default one region as large as the traced heap is used.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef HEAP_REPLAY_ALLOCATOR
+#include HEAP_REPLAY_ALLOCATOR
+#else
+#include "../../portable/MemMang/heap_5.c"
+#define HEAP_REPLAY_REGIONS
+#endif
+
+#define REPLAY_MAX_REGIONS 8
+
+/* The heap is replayed single threaded, the scheduler never runs */
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+	return pdFALSE;
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+	return taskSCHEDULER_NOT_STARTED;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+	return NULL;
+}
+
+struct replay_map_entry {
+	uint32_t ulTargetAddr;
+	uint32_t ulSize;
+	void *pvHostAddr;
+};
+
+struct replay_latency {
+	uint64_t *pullNs;
+	size_t xCount;
+};
+
+static struct replay_map_entry *pxMap;
+static size_t xMapSize;
+
+static struct alloc_trace_header xHeader;
+static struct alloc_trace_record *pxRecords;
+
+static uint8_t *pucRegion[REPLAY_MAX_REGIONS];
+static size_t xRegionSize[REPLAY_MAX_REGIONS];
+static size_t xRegionHighWater[REPLAY_MAX_REGIONS];
+static int iRegionNums;
+
+// prvMapSlot, open addressing with linear probing
+static struct replay_map_entry *prvMapSlot(uint32_t ulAddr)
+{
+	size_t i = (ulAddr * 2654435761u) & (xMapSize - 1);
+
+	while (pxMap[i].ulTargetAddr && pxMap[i].ulTargetAddr != ulAddr)
+		i = (i + 1) & (xMapSize - 1);
+	return &pxMap[i];
+}
+
+// prvMapRemove
+static void prvMapRemove(struct replay_map_entry *pxEntry)
+{
+	size_t i = pxEntry - pxMap, j = i, k;
+
+	/* Move later entries of the probe chain back into the hole */
+	for (;;) {
+		pxMap[i].ulTargetAddr = 0;
+		for (;;) {
+			j = (j + 1) & (xMapSize - 1);
+			if (!pxMap[j].ulTargetAddr)
+				return;
+			k = (pxMap[j].ulTargetAddr * 2654435761u) & (xMapSize - 1);
+			if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+				continue;
+			break;
+		}
+		pxMap[i] = pxMap[j];
+		i = j;
+	}
+}
+
+// prvNow
+static uint64_t prvNow(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// prvCmpU64
+static int prvCmpU64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+// prvPrintLatency
+static void prvPrintLatency(const char *pcName, struct replay_latency *pxLat)
+{
+	static const unsigned int uPerMille[] = {500, 900, 990, 999};
+	size_t i;
+
+	if (!pxLat->xCount)
+		return;
+	qsort(pxLat->pullNs, pxLat->xCount, sizeof(uint64_t), prvCmpU64);
+	printf("%-8s n=%-8zu", pcName, pxLat->xCount);
+	for (i = 0; i < sizeof(uPerMille) / sizeof(uPerMille[0]); i++)
+		printf(" p%-4g %6llu", uPerMille[i] / 10.0,
+		       (unsigned long long)pxLat->pullNs[pxLat->xCount * uPerMille[i] / 1000]);
+	printf(" max %6llu (ns)\n", (unsigned long long)pxLat->pullNs[pxLat->xCount - 1]);
+}
+
+/* Free space of the allocator, returns the largest free block. */
+static size_t prvLargestFreeBlock(size_t *pxFreeBlocks)
+{
+	BlockLink_t *pxBlock;
+	size_t xLargest = 0;
+
+	*pxFreeBlocks = 0;
+	if (!pxEnd)
+		return 0;
+	for (pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock) {
+		if (pxBlock->xBlockSize > xLargest)
+			xLargest = pxBlock->xBlockSize;
+		(*pxFreeBlocks)++;
+	}
+	return xLargest;
+}
+
+// prvFragmentation, 0 when all free space is one block
+static double prvFragmentation(void)
+{
+	size_t xFree = xPortGetFreeHeapSize(), xBlocks;
+
+	if (!xFree)
+		return 0.0;
+	return 1.0 - (double)prvLargestFreeBlock(&xBlocks) / xFree;
+}
+
+// prvTrackHighWater
+static void prvTrackHighWater(void *pv, size_t xSize)
+{
+	uint8_t *puc = pv;
+	int i;
+
+	for (i = 0; i < iRegionNums; i++) {
+		if (puc >= pucRegion[i] && puc < pucRegion[i] + xRegionSize[i]) {
+			if ((size_t)(puc + xSize - pucRegion[i]) > xRegionHighWater[i])
+				xRegionHighWater[i] = puc + xSize - pucRegion[i];
+			return;
+		}
+	}
+}
+
+// prvHexValue
+static int prvHexValue(int c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/* Read a console log with "atrace:" lines or a raw dump into one buffer. */
+static uint8_t *prvLoadTrace(const char *pcPath, size_t *pxLen)
+{
+	FILE *fp = fopen(pcPath, "rb");
+	uint8_t *pucBuf = NULL;
+	size_t xCap = 0, xLen = 0, n;
+	char *pcLine = NULL, *pc;
+	uint32_t ulMagic = 0;
+
+	if (!fp)
+		return NULL;
+
+	if (fread(&ulMagic, sizeof(ulMagic), 1, fp) == 1 && ulMagic == ALLOC_TRACE_MAGIC) {
+		fseek(fp, 0, SEEK_END);
+		xLen = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		pucBuf = malloc(xLen);
+		if (pucBuf && fread(pucBuf, 1, xLen, fp) != xLen)
+			xLen = 0;
+	} else {
+		rewind(fp);
+		while (getline(&pcLine, &n, fp) > 0) {
+			pc = strstr(pcLine, "atrace:");
+			if (!pc)
+				continue;
+			for (pc += 7; prvHexValue(pc[0]) >= 0 && prvHexValue(pc[1]) >= 0; pc += 2) {
+				if (xLen == xCap) {
+					xCap = xCap ? xCap * 2 : 4096;
+					pucBuf = realloc(pucBuf, xCap);
+					if (!pucBuf)
+						goto out;
+				}
+				pucBuf[xLen++] = prvHexValue(pc[0]) << 4 | prvHexValue(pc[1]);
+			}
+		}
+	}
+out:
+	free(pcLine);
+	fclose(fp);
+	*pxLen = xLen;
+	return pucBuf;
+}
+
+// prvParseRegions
+static int prvParseRegions(const char *pcArg)
+{
+	char *pcEnd;
+
+	iRegionNums = 0;
+	while (*pcArg && iRegionNums < REPLAY_MAX_REGIONS) {
+		xRegionSize[iRegionNums++] = strtoul(pcArg, &pcEnd, 0);
+		if (pcEnd == pcArg)
+			return -1;
+		if (*pcEnd == 'k' || *pcEnd == 'K')
+			xRegionSize[iRegionNums - 1] <<= 10, pcEnd++;
+		if (*pcEnd == ',')
+			pcEnd++;
+		pcArg = pcEnd;
+	}
+	return *pcArg ? -1 : 0;
+}
+
+// prvSetupHeap
+static int prvSetupHeap(void)
+{
+	int i;
+#ifdef HEAP_REPLAY_REGIONS
+	HeapRegion_t xRegions[REPLAY_MAX_REGIONS + 1], xTmp;
+	int j;
+
+	if (!iRegionNums) {
+		/* Room for the start alignment and the end marker of heap_5 */
+		xRegionSize[0] = xHeader.ulHeapBytes + 4 * xHeapStructSize;
+		iRegionNums = 1;
+	}
+
+	for (i = 0; i < iRegionNums; i++) {
+		xRegions[i].pucStartAddress = malloc(xRegionSize[i]);
+		xRegions[i].xSizeInBytes = xRegionSize[i];
+		if (!xRegions[i].pucStartAddress)
+			return -1;
+	}
+
+	/* heap_5 needs the regions in address order */
+	for (i = 1; i < iRegionNums; i++) {
+		xTmp = xRegions[i];
+		for (j = i; j > 0 && xRegions[j - 1].pucStartAddress > xTmp.pucStartAddress; j--)
+			xRegions[j] = xRegions[j - 1];
+		xRegions[j] = xTmp;
+	}
+	for (i = 0; i < iRegionNums; i++) {
+		pucRegion[i] = xRegions[i].pucStartAddress;
+		xRegionSize[i] = xRegions[i].xSizeInBytes;
+	}
+	xRegions[i].pucStartAddress = NULL;
+	xRegions[i].xSizeInBytes = 0;
+	vPortDefineHeapRegions(xRegions);
+#else
+	(void)i;
+	pucRegion[0] = ucHeap;
+	xRegionSize[0] = configTOTAL_HEAP_SIZE;
+	iRegionNums = 1;
+#endif
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct replay_latency xMallocLat = {0}, xFreeLat = {0};
+	struct replay_map_entry *pxEntry;
+	struct alloc_trace_record *pxRec;
+	size_t xLen, xUsed, xPeakUsed = 0, xLive = 0, xPeakLive = 0, xBlocks;
+	size_t xFailed = 0, xTargetFailed = 0, xUnknownFree = 0, xReallocs = 0, i;
+	double dFrag, dMaxFrag = 0.0, dPeakFrag = 0.0;
+	uint8_t *pucTrace;
+	uint64_t t;
+	void *pv;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "r:")) != -1) {
+		if (opt != 'r' || prvParseRegions(optarg)) {
+			fprintf(stderr, "usage: %s [-r size[,size...]] trace\n", argv[0]);
+			return 2;
+		}
+	}
+	if (optind >= argc) {
+		fprintf(stderr, "usage: %s [-r size[,size...]] trace\n", argv[0]);
+		return 2;
+	}
+
+	pucTrace = prvLoadTrace(argv[optind], &xLen);
+	if (!pucTrace || xLen < sizeof(xHeader)) {
+		fprintf(stderr, "%s: no trace found\n", argv[optind]);
+		return 1;
+	}
+	memcpy(&xHeader, pucTrace, sizeof(xHeader));
+	if (xHeader.ulMagic != ALLOC_TRACE_MAGIC || xHeader.usVersion != ALLOC_TRACE_VERSION ||
+	    xHeader.usRecordSize != sizeof(struct alloc_trace_record)) {
+		fprintf(stderr, "%s: unsupported trace format\n", argv[optind]);
+		return 1;
+	}
+	if (xHeader.ulCount > (xLen - sizeof(xHeader)) / sizeof(struct alloc_trace_record)) {
+		fprintf(stderr, "%s: trace truncated\n", argv[optind]);
+		xHeader.ulCount = (xLen - sizeof(xHeader)) / sizeof(struct alloc_trace_record);
+	}
+	pxRecords = (struct alloc_trace_record *)(pucTrace + sizeof(xHeader));
+
+	for (xMapSize = 64; xMapSize < 2 * xHeader.ulCount; xMapSize <<= 1)
+		;
+	pxMap = calloc(xMapSize, sizeof(*pxMap));
+	xMallocLat.pullNs = malloc(xHeader.ulCount * sizeof(uint64_t) + 1);
+	xFreeLat.pullNs = malloc(xHeader.ulCount * sizeof(uint64_t) + 1);
+	if (!pxMap || !xMallocLat.pullNs || !xFreeLat.pullNs || prvSetupHeap()) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < xHeader.ulCount; i++) {
+		pxRec = &pxRecords[i];
+		switch (pxRec->ucType) {
+		case ALLOC_TRACE_MALLOC:
+		case ALLOC_TRACE_MALLOC_ALIGN:
+		case ALLOC_TRACE_MALLOC_RSV_ALIGN:
+			/* Requests that failed on the target are replayed as well */
+			t = prvNow();
+#ifdef HEAP_REPLAY_REGIONS
+			if (pxRec->ucType == ALLOC_TRACE_MALLOC_ALIGN)
+				pv = pvPortMallocAlign(pxRec->ulSize,
+						       ((size_t)1 << pxRec->ucAlignShift) - 1);
+			else if (pxRec->ucType == ALLOC_TRACE_MALLOC_RSV_ALIGN)
+				pv = pvPortMallocRsvAlign(pxRec->ulSize,
+							  ((size_t)1 << pxRec->ucAlignShift) - 1);
+			else
+#endif
+				pv = pvPortMalloc(pxRec->ulSize);
+			xMallocLat.pullNs[xMallocLat.xCount++] = prvNow() - t;
+
+			if (!pv) {
+				if (pxRec->ulAddr)
+					xFailed++;
+				break;
+			}
+			if (!pxRec->ulAddr) {
+				/* Failed on the target only, nothing will free it */
+				vPortFree(pv);
+				xTargetFailed++;
+				break;
+			}
+			pxEntry = prvMapSlot(pxRec->ulAddr);
+			pxEntry->ulTargetAddr = pxRec->ulAddr;
+			pxEntry->ulSize = pxRec->ulSize;
+			pxEntry->pvHostAddr = pv;
+			xLive += pxRec->ulSize;
+			prvTrackHighWater(pv, pxRec->ulSize);
+			break;
+		case ALLOC_TRACE_FREE:
+			pxEntry = prvMapSlot(pxRec->ulAddr);
+			if (!pxEntry->ulTargetAddr) {
+				/* Allocated before the trace started, or failed in the replay */
+				xUnknownFree++;
+				break;
+			}
+			t = prvNow();
+			vPortFree(pxEntry->pvHostAddr);
+			xFreeLat.pullNs[xFreeLat.xCount++] = prvNow() - t;
+			xLive -= pxEntry->ulSize;
+			prvMapRemove(pxEntry);
+			break;
+		case ALLOC_TRACE_REALLOC:
+			/* The malloc and free of the realloc follow as own records */
+			xReallocs++;
+			break;
+		default:
+			break;
+		}
+
+		xUsed = xPortGetTotalHeapSize() - xPortGetFreeHeapSize();
+		dFrag = prvFragmentation();
+		if (dFrag > dMaxFrag)
+			dMaxFrag = dFrag;
+		if (xUsed > xPeakUsed) {
+			xPeakUsed = xUsed;
+			dPeakFrag = dFrag;
+		}
+		if (xLive > xPeakLive)
+			xPeakLive = xLive;
+	}
+
+	printf("trace: %u records, %u dropped on target, %zu reallocs, %u heap bytes on target\n",
+	       xHeader.ulCount, xHeader.ulDropped, xReallocs, xHeader.ulHeapBytes);
+	if (xHeader.ulCount)
+		printf("span: %u us\n", pxRecords[xHeader.ulCount - 1].ulTimestamp -
+					     pxRecords[0].ulTimestamp);
+	printf("replay: %zu failed allocations, %zu failed on target only, %zu frees of unknown blocks\n",
+	       xFailed, xTargetFailed, xUnknownFree);
+	printf("footprint: peak %zu bytes in use of %zu, peak %zu bytes requested\n", xPeakUsed,
+	       xPortGetTotalHeapSize(), xPeakLive);
+	for (i = 0; i < (size_t)iRegionNums; i++)
+		printf("  region %zu: %zu bytes, high water %zu\n", i, xRegionSize[i],
+		       xRegionHighWater[i]);
+	prvLargestFreeBlock(&xBlocks);
+	printf("fragmentation: %.3f at peak, %.3f max, %.3f at end (%zu free blocks)\n", dPeakFrag,
+	       dMaxFrag, prvFragmentation(), xBlocks);
+	prvPrintLatency("malloc", &xMallocLat);
+	prvPrintLatency("free", &xFreeLat);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Host port for heap_replay, the replay is single threaded. */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef unsigned long StackType_t;
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portSTACK_GROWTH (-1)
+#define portTICK_PERIOD_MS 1
+#define portBYTE_ALIGNMENT 8
+
+#define portYIELD()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portSET_INTERRUPT_MASK_FROM_ISR() 0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) (void)(x)
+#define portTASK_FUNCTION_PROTO(f, p) void f(void *p)
+#define portTASK_FUNCTION(f, p) void f(void *p)
+#define portNOP()
+
+#endif
@@ -0,0 +1,874 @@
+/*
+ * Copyright (c) 2021-2022 Amlogic, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "topic.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if( configUSE_PREEMPTION == 0 )
+	#define topicYIELD_IF_USING_PREEMPTION()
+#else
+	#define topicYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* Samples are numbered from 0 in the order they are published.  ulPublished is
+the number of the next sample, and each subscriber keeps the number of the
+next sample it reads, so the difference is the number of samples it has not
+read.  Only differences are used, so the numbers can wrap.  A lossless
+subscriber must never be more than uxDepth samples behind, so publishing waits
+or fails while the slowest lossless subscribers are that far behind.  The topic
+keeps where the slowest ones are and how many there are, so publishing does not
+look at the subscribers.  The list of lossless subscribers is only walked when
+the last of the slowest ones reads a sample or unsubscribes. */
+typedef struct TopicDef_t
+{
+	uint8_t *pucStorage;				/*< The ring of samples. */
+	UBaseType_t uxDepth;				/*< The number of samples in the ring. */
+	UBaseType_t uxSampleSize;			/*< The size of each sample. */
+	UBaseType_t uxWriteIndex;			/*< The slot the next sample is written to. */
+	UBaseType_t uxSubscribers;			/*< The number of subscribers. */
+	volatile uint32_t ulPublished;		/*< The number of the next sample. */
+	List_t xTasksWaiting;				/*< Tasks blocked in xTopicReceive(), in priority order. */
+	List_t xTasksWaitingToPublish;		/*< Tasks blocked in xTopicPublish(), in priority order. */
+	List_t xLosslessSubscribers;		/*< The subscribers in eTopicReadLossless mode. */
+	uint32_t ulLosslessTail;			/*< The next sample of the slowest lossless subscribers. */
+	UBaseType_t uxLosslessAtTail;		/*< The number of lossless subscribers at ulLosslessTail, 0 if there are none. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the topic is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} Topic_t;
+
+typedef struct TopicSubscriberDef_t
+{
+	Topic_t *pxTopic;					/*< The topic subscribed to. */
+	ListItem_t xLosslessListItem;		/*< Used to reference the subscriber from the list of lossless subscribers of the topic. */
+	uint32_t ulNext;					/*< The number of the next sample to read. */
+	uint32_t ulOverruns;				/*< The number of samples skipped. */
+	uint8_t ucMode;						/*< An eTopicReadMode value. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the subscriber is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} TopicSubscriber_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a topic that has been allocated.
+ */
+static void prvInitialiseTopic( Topic_t * const pxTopic, const UBaseType_t uxDepth, const UBaseType_t uxSampleSize, uint8_t * const pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set up a subscriber that has been allocated.
+ */
+static void prvInitialiseSubscriber( TopicSubscriber_t * const pxSubscriber, Topic_t * const pxTopic, const eTopicReadMode eMode ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy a sample into the ring and unblock every waiting task.  Returns pdTRUE
+ * if one of them has a priority above the calling task.  Called with
+ * interrupts masked.
+ */
+static BaseType_t prvPublish( Topic_t * const pxTopic, const void * const pvSample ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if publishing a sample would overwrite a sample that a
+ * lossless subscriber has not read.  Called with interrupts masked.
+ */
+static BaseType_t prvIsFull( const Topic_t * const pxTopic ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record that a lossless subscriber is no longer at ulOldNext, after it read a
+ * sample or was removed from the list of lossless subscribers.  Returns pdTRUE
+ * if that leaves no lossless subscriber at the tail, which may make room for
+ * publishers.  Called with interrupts masked.
+ */
+static BaseType_t prvLosslessLeave( Topic_t * const pxTopic, const uint32_t ulOldNext ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task waiting to publish.  Returns pdTRUE if one of them has a
+ * priority above the calling task.  Called with interrupts masked.
+ */
+static BaseType_t prvUnblockPublishers( Topic_t * const pxTopic ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the next sample for the subscriber into pvBuffer, and let waiting
+ * publishers retry if the subscriber was the last of the slowest lossless
+ * ones.  Returns pdFALSE if the
+ * subscriber has read every sample.  Called with interrupts masked, from a
+ * task.
+ */
+static BaseType_t prvRead( TopicSubscriber_t * const pxSubscriber, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	TopicHandle_t xTopicCreateStatic( UBaseType_t uxDepth, UBaseType_t uxSampleSize, uint8_t *pucTopicStorageBuffer, StaticTopic_t *pxTopicBuffer )
+	{
+	Topic_t *pxTopic;
+
+		configASSERT( pxTopicBuffer );
+		configASSERT( pucTopicStorageBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structures used to declare
+			variables of type StaticTopic_t and StaticTopicSubscriber_t equal
+			the size of the real structures. */
+			volatile size_t xSize = sizeof( StaticTopic_t );
+			configASSERT( xSize == sizeof( Topic_t ) );
+			xSize = sizeof( StaticTopicSubscriber_t );
+			configASSERT( xSize == sizeof( TopicSubscriber_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		pxTopic = ( Topic_t * ) pxTopicBuffer; /*lint !e740 !e9087 Topic_t and StaticTopic_t are deliberately aliased for data hiding purposes. */
+
+		if( pxTopic != NULL )
+		{
+			prvInitialiseTopic( pxTopic, uxDepth, uxSampleSize, pucTopicStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxTopic->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+			traceTOPIC_CREATE( pxTopic );
+		}
+		else
+		{
+			traceTOPIC_CREATE_FAILED();
+		}
+
+		return pxTopic;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TopicHandle_t xTopicCreate( UBaseType_t uxDepth, UBaseType_t uxSampleSize )
+	{
+	Topic_t *pxTopic;
+
+		pxTopic = ( Topic_t * ) pvPortMalloc( sizeof( Topic_t ) + ( ( size_t ) uxDepth * ( size_t ) uxSampleSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxTopic != NULL )
+		{
+			prvInitialiseTopic( pxTopic, uxDepth, uxSampleSize, ( ( uint8_t * ) pxTopic ) + sizeof( Topic_t ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxTopic->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			traceTOPIC_CREATE( pxTopic );
+		}
+		else
+		{
+			traceTOPIC_CREATE_FAILED(); /*lint !e9063 Else branch only exists to allow tracing and does not generate code if trace macros are not defined. */
+		}
+
+		return pxTopic;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTopic( Topic_t * const pxTopic, const UBaseType_t uxDepth, const UBaseType_t uxSampleSize, uint8_t * const pucStorage )
+{
+	configASSERT( uxDepth != 0U );
+	configASSERT( uxSampleSize != 0U );
+
+	pxTopic->pucStorage = pucStorage;
+	pxTopic->uxDepth = uxDepth;
+	pxTopic->uxSampleSize = uxSampleSize;
+	pxTopic->uxWriteIndex = 0U;
+	pxTopic->uxSubscribers = 0U;
+	pxTopic->ulPublished = 0U;
+	vListInitialise( &( pxTopic->xTasksWaiting ) );
+	vListInitialise( &( pxTopic->xTasksWaitingToPublish ) );
+	vListInitialise( &( pxTopic->xLosslessSubscribers ) );
+	pxTopic->ulLosslessTail = 0U;
+	pxTopic->uxLosslessAtTail = 0U;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic, eTopicReadMode eMode, StaticTopicSubscriber_t *pxSubscriberBuffer )
+	{
+	TopicSubscriber_t *pxSubscriber;
+
+		configASSERT( xTopic );
+		configASSERT( pxSubscriberBuffer );
+
+		pxSubscriber = ( TopicSubscriber_t * ) pxSubscriberBuffer; /*lint !e740 !e9087 TopicSubscriber_t and StaticTopicSubscriber_t are deliberately aliased for data hiding purposes. */
+
+		if( pxSubscriber != NULL )
+		{
+			prvInitialiseSubscriber( pxSubscriber, xTopic, eMode );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxSubscriber->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxSubscriber;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic, eTopicReadMode eMode )
+	{
+	TopicSubscriber_t *pxSubscriber;
+
+		configASSERT( xTopic );
+
+		pxSubscriber = ( TopicSubscriber_t * ) pvPortMalloc( sizeof( TopicSubscriber_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+		if( pxSubscriber != NULL )
+		{
+			prvInitialiseSubscriber( pxSubscriber, xTopic, eMode );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxSubscriber->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxSubscriber;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseSubscriber( TopicSubscriber_t * const pxSubscriber, Topic_t * const pxTopic, const eTopicReadMode eMode )
+{
+	configASSERT( ( eMode == eTopicReadLatest ) || ( eMode == eTopicReadAll ) || ( eMode == eTopicReadLossless ) );
+
+	pxSubscriber->pxTopic = pxTopic;
+	pxSubscriber->ulOverruns = 0U;
+	pxSubscriber->ucMode = ( uint8_t ) eMode;
+	vListInitialiseItem( &( pxSubscriber->xLosslessListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxSubscriber->xLosslessListItem ), pxSubscriber );
+
+	taskENTER_CRITICAL();
+	{
+		/* Start at the last sample published, if there is one. */
+		pxSubscriber->ulNext = ( pxTopic->ulPublished != 0U ) ? ( pxTopic->ulPublished - 1U ) : 0U;
+		( pxTopic->uxSubscribers )++;
+
+		if( eMode == eTopicReadLossless )
+		{
+			vListInsertEnd( &( pxTopic->xLosslessSubscribers ), &( pxSubscriber->xLosslessListItem ) );
+
+			if( ( pxTopic->uxLosslessAtTail == 0U ) || ( ( pxTopic->ulPublished - pxSubscriber->ulNext ) > ( pxTopic->ulPublished - pxTopic->ulLosslessTail ) ) )
+			{
+				pxTopic->ulLosslessTail = pxSubscriber->ulNext;
+				pxTopic->uxLosslessAtTail = 1U;
+			}
+			else if( pxSubscriber->ulNext == pxTopic->ulLosslessTail )
+			{
+				( pxTopic->uxLosslessAtTail )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	traceTOPIC_SUBSCRIBE( pxTopic, pxSubscriber );
+}
+/*-----------------------------------------------------------*/
+
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber )
+{
+TopicSubscriber_t * const pxSubscriber = xSubscriber;
+
+	configASSERT( pxSubscriber );
+
+	traceTOPIC_UNSUBSCRIBE( pxSubscriber->pxTopic, pxSubscriber );
+
+	taskENTER_CRITICAL();
+	{
+		( pxSubscriber->pxTopic->uxSubscribers )--;
+
+		/* A lossless subscriber that leaves may be the one publishers wait
+		for. */
+		if( pxSubscriber->ucMode == ( uint8_t ) eTopicReadLossless )
+		{
+			( void ) uxListRemove( &( pxSubscriber->xLosslessListItem ) );
+
+			if( ( prvLosslessLeave( pxSubscriber->pxTopic, pxSubscriber->ulNext ) != pdFALSE ) && ( prvUnblockPublishers( pxSubscriber->pxTopic ) != pdFALSE ) )
+			{
+				topicYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxSubscriber );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxSubscriber->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxSubscriber );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicPublish( TopicHandle_t xTopic, const void * const pvSample, TickType_t xTicksToWait )
+{
+Topic_t * const pxTopic = xTopic;
+BaseType_t xReturn, xEntryTimeSet = pdFALSE, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxTopic );
+	configASSERT( pvSample );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( prvIsFull( pxTopic ) == pdFALSE )
+			{
+				traceTOPIC_PUBLISH( pxTopic );
+
+				if( prvPublish( pxTopic, pvSample ) != pdFALSE )
+				{
+					topicYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xReturn == pdPASS ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Cannot block if the scheduler is suspended.  Only checked here as
+		topics without lossless subscribers never block. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+		}
+		#endif
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Lossless subscribers read from other tasks with interrupts
+			masked, so test for room and block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( prvIsFull( pxTopic ) != pdFALSE )
+				{
+					traceBLOCKING_ON_TOPIC_PUBLISH( pxTopic );
+					vTaskPlaceOnEventList( &( pxTopic->xTasksWaitingToPublish ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+			break;
+		}
+	}
+
+	if( xReturn != pdPASS )
+	{
+		traceTOPIC_PUBLISH_FAILED( pxTopic );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTopicPublish( TopicHandle_t xTopic, const void * const pvSample )
+{
+	/* Only waits if the topic has a lossless subscriber. */
+	while( xTopicPublish( xTopic, pvSample, portMAX_DELAY ) != pdPASS )
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+Topic_t * const pxTopic = xTopic;
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xYieldRequired = pdFALSE, xReturn;
+
+	configASSERT( pxTopic );
+	configASSERT( pvSample );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( prvIsFull( pxTopic ) == pdFALSE )
+		{
+			traceTOPIC_PUBLISH_FROM_ISR( pxTopic );
+			xYieldRequired = prvPublish( pxTopic, pvSample );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceTOPIC_PUBLISH_FROM_ISR_FAILED( pxTopic );
+			xReturn = errQUEUE_FULL;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTopicPublishFromISR( TopicHandle_t xTopic, const void * const pvSample, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+	( void ) xTopicPublishFromISR( xTopic, pvSample, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber, void * const pvBuffer, TickType_t xTicksToWait )
+{
+TopicSubscriber_t * const pxSubscriber = xSubscriber;
+Topic_t *pxTopic;
+BaseType_t xReturn, xEntryTimeSet = pdFALSE, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxSubscriber );
+	configASSERT( pvBuffer );
+
+	pxTopic = pxSubscriber->pxTopic;
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvRead( pxSubscriber, pvBuffer );
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xReturn != pdFALSE ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskInternalSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vTaskSuspendAll();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			xBlocked = pdFALSE;
+
+			/* Samples are published from interrupts too, so test for a sample
+			and block in one critical section. */
+			taskENTER_CRITICAL();
+			{
+				if( pxTopic->ulPublished == pxSubscriber->ulNext )
+				{
+					traceBLOCKING_ON_TOPIC_RECEIVE( pxTopic, pxSubscriber );
+					vTaskPlaceOnEventList( &( pxTopic->xTasksWaiting ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+
+			/* Timed out, take a last look. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvRead( pxSubscriber, pvBuffer );
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	if( xReturn != pdFALSE )
+	{
+		traceTOPIC_RECEIVE( pxTopic, pxSubscriber );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		traceTOPIC_RECEIVE_FAILED( pxTopic, pxSubscriber );
+		xReturn = errQUEUE_EMPTY;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTopicGetOverruns( TopicSubscriberHandle_t xSubscriber )
+{
+const TopicSubscriber_t * const pxSubscriber = xSubscriber;
+
+	configASSERT( pxSubscriber );
+
+	return pxSubscriber->ulOverruns;
+}
+/*-----------------------------------------------------------*/
+
+void vTopicDelete( TopicHandle_t xTopic )
+{
+Topic_t * const pxTopic = xTopic;
+
+	configASSERT( pxTopic );
+	configASSERT( pxTopic->uxSubscribers == 0U );
+
+	traceTOPIC_DELETE( pxTopic );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxTopic );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxTopic->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxTopic );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublish( Topic_t * const pxTopic, const void * const pvSample )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	( void ) memcpy( ( void * ) &( pxTopic->pucStorage[ ( size_t ) pxTopic->uxWriteIndex * ( size_t ) pxTopic->uxSampleSize ] ), pvSample, ( size_t ) pxTopic->uxSampleSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+	( pxTopic->uxWriteIndex )++;
+
+	if( pxTopic->uxWriteIndex == pxTopic->uxDepth )
+	{
+		pxTopic->uxWriteIndex = 0U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( pxTopic->ulPublished )++;
+
+	/* Every task waiting has read all the earlier samples, so each has this
+	one to read. */
+	while( listLIST_IS_EMPTY( &( pxTopic->xTasksWaiting ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxTopic->xTasksWaiting ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsFull( const Topic_t * const pxTopic )
+{
+BaseType_t xReturn;
+
+	if( ( pxTopic->uxLosslessAtTail != 0U ) && ( ( pxTopic->ulPublished - pxTopic->ulLosslessTail ) >= ( uint32_t ) pxTopic->uxDepth ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvLosslessLeave( Topic_t * const pxTopic, const uint32_t ulOldNext )
+{
+ListItem_t const *pxListItem;
+ListItem_t const *pxListEnd;
+const TopicSubscriber_t *pxSubscriber;
+BaseType_t xReturn = pdFALSE;
+
+	if( ulOldNext == pxTopic->ulLosslessTail )
+	{
+		( pxTopic->uxLosslessAtTail )--;
+
+		if( pxTopic->uxLosslessAtTail == 0U )
+		{
+			/* The last of the slowest subscribers moved on, find the slowest
+			ones again. */
+			pxListEnd = listGET_END_MARKER( &( pxTopic->xLosslessSubscribers ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+			for( pxListItem = listGET_HEAD_ENTRY( &( pxTopic->xLosslessSubscribers ) ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+			{
+				pxSubscriber = ( const TopicSubscriber_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+
+				if( ( pxTopic->uxLosslessAtTail == 0U ) || ( ( pxTopic->ulPublished - pxSubscriber->ulNext ) > ( pxTopic->ulPublished - pxTopic->ulLosslessTail ) ) )
+				{
+					pxTopic->ulLosslessTail = pxSubscriber->ulNext;
+					pxTopic->uxLosslessAtTail = 1U;
+				}
+				else if( pxSubscriber->ulNext == pxTopic->ulLosslessTail )
+				{
+					( pxTopic->uxLosslessAtTail )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockPublishers( Topic_t * const pxTopic )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	/* Each task tests again for room when it runs, as another lossless
+	subscriber may still be uxDepth samples behind. */
+	while( listLIST_IS_EMPTY( &( pxTopic->xTasksWaitingToPublish ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxTopic->xTasksWaitingToPublish ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRead( TopicSubscriber_t * const pxSubscriber, void * const pvBuffer )
+{
+Topic_t * const pxTopic = pxSubscriber->pxTopic;
+uint32_t ulUnread = pxTopic->ulPublished - pxSubscriber->ulNext;
+uint32_t ulKeep;
+UBaseType_t uxIndex;
+BaseType_t xReturn;
+
+	if( ulUnread != 0U )
+	{
+		/* Skip to the newest sample, or to the oldest still in the ring.
+		Publishing never lets a lossless subscriber fall that far behind. */
+		ulKeep = ( pxSubscriber->ucMode == ( uint8_t ) eTopicReadLatest ) ? 1U : ( uint32_t ) pxTopic->uxDepth;
+
+		if( ulUnread > ulKeep )
+		{
+			pxSubscriber->ulOverruns += ulUnread - ulKeep;
+			pxSubscriber->ulNext += ulUnread - ulKeep;
+			ulUnread = ulKeep;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The sample is ulUnread slots behind the write index. */
+		uxIndex = ( ( UBaseType_t ) ulUnread <= pxTopic->uxWriteIndex ) ? ( pxTopic->uxWriteIndex - ( UBaseType_t ) ulUnread ) : ( pxTopic->uxWriteIndex + pxTopic->uxDepth - ( UBaseType_t ) ulUnread );
+
+		( void ) memcpy( pvBuffer, ( void * ) &( pxTopic->pucStorage[ ( size_t ) uxIndex * ( size_t ) pxTopic->uxSampleSize ] ), ( size_t ) pxTopic->uxSampleSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		( pxSubscriber->ulNext )++;
+		xReturn = pdTRUE;
+
+		if( pxSubscriber->ucMode == ( uint8_t ) eTopicReadLossless )
+		{
+			if( ( prvLosslessLeave( pxTopic, pxSubscriber->ulNext - 1U ) != pdFALSE ) && ( prvUnblockPublishers( pxTopic ) != pdFALSE ) )
+			{
+				topicYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}